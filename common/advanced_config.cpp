@@ -84,16 +84,19 @@ static const wxChar ExtraZoneDisplayModes[] = wxT( "ExtraZoneDisplayModes" );
 static const wxChar MinPlotPenWidth[] = wxT( "MinPlotPenWidth" );
 static const wxChar DebugZoneFiller[] = wxT( "DebugZoneFiller" );
 static const wxChar DebugPDFWriter[] = wxT( "DebugPDFWriter" );
+static const wxChar PDFCompressionLevel[] = wxT( "PDFCompressionLevel" );
 static const wxChar SmallDrillMarkSize[] = wxT( "SmallDrillMarkSize" );
 static const wxChar HotkeysDumper[] = wxT( "HotkeysDumper" );
 static const wxChar DrawBoundingBoxes[] = wxT( "DrawBoundingBoxes" );
 static const wxChar ShowPcbnewExportNetlist[] = wxT( "ShowPcbnewExportNetlist" );
 static const wxChar Skip3DModelFileCache[] = wxT( "Skip3DModelFileCache" );
 static const wxChar Skip3DModelMemoryCache[] = wxT( "Skip3DModelMemoryCache" );
+static const wxChar FootprintCacheSize[] = wxT( "FootprintCacheSize" );
 static const wxChar HideVersionFromTitle[] = wxT( "HideVersionFromTitle" );
 static const wxChar TraceMasks[] = wxT( "TraceMasks" );
 static const wxChar ShowRepairSchematic[] = wxT( "ShowRepairSchematic" );
 static const wxChar ShowEventCounters[] = wxT( "ShowEventCounters" );
+static const wxChar ShowGalFrameStats[] = wxT( "ShowGalFrameStats" );
 static const wxChar AllowManualCanvasScale[] = wxT( "AllowManualCanvasScale" );
 static const wxChar UpdateUIEventInterval[] = wxT( "UpdateUIEventInterval" );
 static const wxChar V3DRT_BevelHeight_um[] = wxT( "V3DRT_BevelHeight_um" );
@@ -232,14 +235,17 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_DebugZoneFiller           = false;
     m_DebugPDFWriter            = false;
+    m_PDFCompressionLevel       = 9;
     m_SmallDrillMarkSize        = 0.35;
     m_HotkeysDumper             = false;
     m_DrawBoundingBoxes         = false;
     m_ShowPcbnewExportNetlist   = false;
     m_Skip3DModelFileCache      = false;
     m_Skip3DModelMemoryCache    = false;
+    m_FootprintCacheSize        = 500;
     m_HideVersionFromTitle      = false;
     m_ShowEventCounters         = false;
+    m_ShowGalFrameStats         = false;
     m_AllowManualCanvasScale    = false;
     m_CompactSave               = false;
     m_UpdateUIEventInterval     = 0;
@@ -408,6 +414,10 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugPDFWriter,
                                                 &m_DebugPDFWriter, m_DebugPDFWriter ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::PDFCompressionLevel,
+                                               &m_PDFCompressionLevel, m_PDFCompressionLevel,
+                                               0, 9 ) );
+
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::SmallDrillMarkSize,
                                                   &m_SmallDrillMarkSize, m_SmallDrillMarkSize,
                                                   0.0, 3.0 ) );
@@ -428,6 +438,10 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::Skip3DModelMemoryCache,
                                                 &m_Skip3DModelMemoryCache, m_Skip3DModelMemoryCache ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::FootprintCacheSize,
+                                               &m_FootprintCacheSize, m_FootprintCacheSize,
+                                               0, 100000 ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::HideVersionFromTitle,
                                                 &m_HideVersionFromTitle, m_HideVersionFromTitle ) );
 
@@ -437,6 +451,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowEventCounters,
                                                 &m_ShowEventCounters, m_ShowEventCounters ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowGalFrameStats,
+                                                &m_ShowGalFrameStats, m_ShowGalFrameStats ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::AllowManualCanvasScale,
                                                 &m_AllowManualCanvasScale,
                                                 m_AllowManualCanvasScale ) );
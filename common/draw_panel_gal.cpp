@@ -24,6 +24,7 @@
  * or you may write to the Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
+#include <advanced_config.h>
 #include <eda_draw_frame.h>
 #include <kiface_base.h>
 #include <macros.h>
@@ -53,6 +54,7 @@
 #include <core/profile.h>
 
 #include <pgm_base.h>
+#include <paths.h>
 #include <confirm.h>
 
 
@@ -174,6 +176,14 @@ EDA_DRAW_PANEL_GAL::~EDA_DRAW_PANEL_GAL()
 
     wxASSERT( !m_drawing );
 
+    if( IsShowingFrameStats() )
+    {
+        wxFileName fn( PATHS::GetUserCachePath(), wxS( "gal_frame_stats.csv" ) );
+
+        if( ExportFrameStats( fn.GetFullPath() ) )
+            wxLogTrace( traceGalProfile, wxS( "Frame statistics written to %s" ), fn.GetFullPath() );
+    }
+
     delete m_viewControls;
     delete m_view;
     delete m_gal;
@@ -300,6 +310,26 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
 
         // ctx goes out of scope here so destructor would be called
         cntCtxDestroy.Stop();
+
+        // The GAL counters are only complete once the drawing context has been flushed
+        KIGFX::VIEW_FRAME_STATS& frameStats = m_view->GetFrameStats();
+
+        if( frameStats.IsRecording() )
+        {
+            frameStats.EndFrame( m_gal->GetDrawStats() );
+
+            if( m_frameStatsOverlay )
+            {
+                frameStats.DrawOverlay( *m_frameStatsOverlay, *m_view );
+
+                // Without a separate overlay target, refreshing the overlay would force a full
+                // redraw and thus a new frame; the new text will show up with the next one.
+                if( m_gal->HasTarget( KIGFX::TARGET_OVERLAY ) )
+                    m_view->Update( m_frameStatsOverlay.get() );
+            }
+        }
+
+        m_gal->ResetDrawStats();
     }
     catch( std::exception& err )
     {
@@ -423,6 +453,9 @@ void EDA_DRAW_PANEL_GAL::SetEventDispatcher( TOOL_DISPATCHER* aEventDispatcher )
 
 void EDA_DRAW_PANEL_GAL::StartDrawing()
 {
+    if( ADVANCED_CFG::GetCfg().m_ShowGalFrameStats && !IsShowingFrameStats() )
+        SetShowFrameStats( true );
+
     // Start querying GAL if it is ready
     m_refreshTimer.StartOnce( 100 );
 }
@@ -689,6 +722,36 @@ void EDA_DRAW_PANEL_GAL::ClearDebugOverlay()
 }
 
 
+void EDA_DRAW_PANEL_GAL::SetShowFrameStats( bool aShow )
+{
+    KIGFX::VIEW_FRAME_STATS& frameStats = m_view->GetFrameStats();
+
+    frameStats.SetEnabled( aShow );
+
+    if( aShow && !m_frameStatsOverlay )
+    {
+        m_frameStatsOverlay.reset( new KIGFX::VIEW_OVERLAY() );
+        m_view->Add( m_frameStatsOverlay.get() );
+    }
+    else if( !aShow && m_frameStatsOverlay )
+    {
+        m_view->Remove( m_frameStatsOverlay.get() );
+        m_frameStatsOverlay = nullptr;
+        frameStats.Clear();
+    }
+
+    // Make sure the next repaint is a full one so it gets recorded
+    m_view->MarkDirty();
+    Refresh();
+}
+
+
+bool EDA_DRAW_PANEL_GAL::ExportFrameStats( const wxString& aFileName )
+{
+    return m_view->GetFrameStats().WriteCsv( aFileName );
+}
+
+
 KIGFX::VC_SETTINGS EDA_DRAW_PANEL_GAL::GetVcSettings()
 {
     COMMON_SETTINGS* cfg = Pgm().GetCommonSettings();
@@ -31,6 +31,58 @@
 // Helper to make the code cleaner when we want this operation
 #define CLAMPED_VAL_INT_MAX( x ) std::min( x, static_cast<size_t>( std::numeric_limits<int>::max() ) )
 
+
+static void normalizeTerm( SEARCH_TERM& aTerm )
+{
+    if( !aTerm.Normalized )
+    {
+        aTerm.Text = aTerm.Text.MakeLower().Trim( false ).Trim( true );
+        aTerm.Normalized = true;
+    }
+}
+
+
+static std::u32string toUTF32( const wxString& aText )
+{
+    std::u32string result;
+    result.reserve( aText.length() );
+
+    for( wxUniChar c : aText )
+        result.push_back( static_cast<char32_t>( c.GetValue() ) );
+
+    return result;
+}
+
+
+void PREPARED_SEARCH_TERMS::Prepare( std::vector<SEARCH_TERM>& aTerms )
+{
+    Texts.clear();
+    Texts.reserve( aTerms.size() );
+    Trigrams = {};
+
+    for( SEARCH_TERM& term : aTerms )
+    {
+        normalizeTerm( term );
+        Texts.push_back( toUTF32( term.Text ) );
+        AddTrigrams( Texts.back(), Trigrams );
+    }
+}
+
+
+void PREPARED_SEARCH_TERMS::AddTrigrams( const std::u32string& aText, TRIGRAM_BITS& aBits )
+{
+    for( size_t i = 2; i < aText.size(); ++i )
+    {
+        uint32_t hash = ( aText[i - 2] * 0x9E3779B1u ) ^ ( aText[i - 1] * 0x85EBCA77u )
+                        ^ ( aText[i] * 0xC2B2AE3Du );
+        hash ^= hash >> 15;
+
+        // The top 8 bits of the mixed hash select one of the 256 bits
+        uint32_t bit = ( hash * 0x2C1B3C6Du ) >> 24;
+        aBits[bit >> 6] |= uint64_t( 1 ) << ( bit & 63 );
+    }
+}
+
 bool EDA_PATTERN_MATCH_SUBSTR::SetPattern( const wxString& aPattern )
 {
     m_pattern = aPattern;
@@ -387,8 +439,22 @@ const std::map<wxString, double> EDA_PATTERN_MATCH_RELATIONAL::m_units = {
 
 EDA_COMBINED_MATCHER::EDA_COMBINED_MATCHER( const wxString& aPattern,
                                             COMBINED_MATCHER_CONTEXT aContext ) :
-        m_pattern( aPattern )
+        m_pattern( aPattern ),
+        m_patternTrigrams()
 {
+    // Regular expressions, wildcards and relational expressions are all recognized by these
+    // characters.  Any other pattern is matched as a plain substring by every matcher.
+    m_isSubstring = aContext != CTX_NETCLASS
+                    && !aPattern.StartsWith( wxS( "/" ) )
+                    && !( aPattern.StartsWith( wxS( "^" ) ) && aPattern.EndsWith( wxS( "$" ) ) )
+                    && aPattern.find_first_of( wxS( "*?<>=" ) ) == wxString::npos;
+
+    if( m_isSubstring )
+    {
+        m_pattern32 = toUTF32( aPattern );
+        PREPARED_SEARCH_TERMS::AddTrigrams( m_pattern32, m_patternTrigrams );
+    }
+
     switch( aContext )
     {
     case CTX_LIBITEM:
@@ -479,11 +545,7 @@ int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms )
 
     for( SEARCH_TERM& term : aWeightedTerms )
     {
-        if( !term.Normalized )
-        {
-            term.Text = term.Text.MakeLower().Trim( false ).Trim( true );
-            term.Normalized = true;
-        }
+        normalizeTerm( term );
 
         int found_pos = EDA_PATTERN_NOT_FOUND;
         int matchers_fired = 0;
@@ -505,6 +567,44 @@ int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms )
 }
 
 
+int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms,
+                                      const PREPARED_SEARCH_TERMS& aPrepared )
+{
+    if( !m_isSubstring || aPrepared.Texts.size() != aWeightedTerms.size() )
+        return ScoreTerms( aWeightedTerms );
+
+    // A substring match needs every trigram of the pattern to be present somewhere
+    for( size_t i = 0; i < m_patternTrigrams.size(); ++i )
+    {
+        if( ( aPrepared.Trigrams[i] & m_patternTrigrams[i] ) != m_patternTrigrams[i] )
+            return 0;
+    }
+
+    int score = 0;
+
+    for( size_t i = 0; i < aPrepared.Texts.size(); ++i )
+    {
+        const std::u32string& text = aPrepared.Texts[i];
+
+        if( text == m_pattern32 )
+        {
+            score += 8 * aWeightedTerms[i].Score;
+        }
+        else
+        {
+            size_t found_pos = text.find( m_pattern32 );
+
+            if( found_pos == 0 )
+                score += 2 * aWeightedTerms[i].Score;
+            else if( found_pos != std::u32string::npos )
+                score += aWeightedTerms[i].Score;
+        }
+    }
+
+    return score;
+}
+
+
 wxString const& EDA_COMBINED_MATCHER::GetPattern() const
 {
     return m_pattern;
@@ -602,11 +602,17 @@ BOX2I EDA_TEXT::GetTextBox( int aLine ) const
 {
     VECTOR2I drawPos = GetDrawPos();
 
-    if( m_bounding_box_cache_valid
-            && m_bounding_box_cache_pos == drawPos
-            && m_bounding_box_cache_line == aLine )
     {
-        return m_bounding_box_cache;
+        // The same text can be measured from several threads (for instance when plotting
+        // layers in parallel)
+        std::lock_guard<std::mutex> lock( m_bounding_box_cache_mutex );
+
+        if( m_bounding_box_cache_valid
+                && m_bounding_box_cache_pos == drawPos
+                && m_bounding_box_cache_line == aLine )
+        {
+            return m_bounding_box_cache;
+        }
     }
 
     BOX2I          bbox;
@@ -723,6 +729,8 @@ BOX2I EDA_TEXT::GetTextBox( int aLine ) const
 
     bbox.Normalize();       // Make h and v sizes always >= 0
 
+    std::lock_guard<std::mutex> lock( m_bounding_box_cache_mutex );
+
     m_bounding_box_cache_valid = true;
     m_bounding_box_cache_pos = drawPos;
     m_bounding_box_cache_line = aLine;
@@ -59,6 +59,8 @@ FONT* FONT::s_defaultFont = nullptr;
 
 std::map< std::tuple<wxString, bool, bool, bool>, FONT*> FONT::s_fontMap;
 
+static std::mutex s_fontMapMutex;
+
 class MARKUP_CACHE
 {
 public:
@@ -146,6 +148,10 @@ FONT* FONT::getDefaultFont()
 FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic,
                      const std::vector<wxString>* aEmbeddedFiles, bool aForDrawingSheet )
 {
+    // Fonts are looked up from worker threads too (for instance when plotting layers in
+    // parallel)
+    std::lock_guard<std::mutex> lock( s_fontMapMutex );
+
     if( aFontName.empty() || aFontName.StartsWith( KICAD_FONT_NAME ) )
         return getDefaultFont();
 
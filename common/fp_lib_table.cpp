@@ -374,6 +374,18 @@ const FOOTPRINT* FP_LIB_TABLE::GetEnumeratedFootprint( const wxString& aNickname
 }
 
 
+bool FP_LIB_TABLE::VisitEnumeratedFootprint( const wxString& aNickname,
+                                             const wxString& aFootprintName,
+                                             const std::function<void( const FOOTPRINT& )>& aVisitor )
+{
+    const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+    wxASSERT( row->plugin );
+
+    return row->plugin->VisitEnumeratedFootprint( row->GetFullURI( true ), aFootprintName,
+                                                  aVisitor, row->GetProperties() );
+}
+
+
 bool FP_LIB_TABLE::FootprintExists( const wxString& aNickname, const wxString& aFootprintName )
 {
     try
@@ -146,6 +146,10 @@ void GPU_CACHED_MANAGER::EndDrawing()
 
     CACHED_CONTAINER* cached = static_cast<CACHED_CONTAINER*>( m_container );
 
+    // A dirty container is (re)uploaded to the GPU when it gets unmapped
+    if( cached->IsDirty() )
+        m_drawStats.uploadBytes += (unsigned long long) cached->AllItemsSize() * VERTEX_SIZE;
+
     if( cached->IsMapped() )
         cached->Unmap();
 
@@ -189,6 +193,8 @@ void GPU_CACHED_MANAGER::EndDrawing()
     {
         VRANGE* cur = &m_vranges[n];
 
+        m_drawStats.vertices += cur->m_end - cur->m_start + 1;
+
         if( cur->m_isContinuous )
         {
             if( icnt > 0 )
@@ -222,6 +228,8 @@ void GPU_CACHED_MANAGER::EndDrawing()
 
     cntDraw.Stop();
 
+    m_drawStats.drawCalls += drawCalls;
+
     KI_TRACE( traceGalProfile,
               "Cached manager size: VBO size %u iranges %zu max elt size %u drawcalls %u\n",
               cached->AllItemsSize(), m_vranges.size(), m_indexBufMaxSize, drawCalls );
@@ -310,6 +318,11 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
 
     glDrawArrays( GL_TRIANGLES, 0, m_container->GetSize() );
 
+    // Noncached vertices are streamed from client memory on every draw
+    m_drawStats.drawCalls++;
+    m_drawStats.vertices += m_container->GetSize();
+    m_drawStats.uploadBytes += (unsigned long long) m_container->GetSize() * VERTEX_SIZE;
+
 #ifdef KICAD_GAL_PROFILE
     wxLogTrace( traceGalProfile, wxT( "Noncached manager size: %d" ), m_container->GetSize() );
 #endif /* KICAD_GAL_PROFILE */
@@ -2116,6 +2116,32 @@ bool OPENGL_GAL::HasTarget( RENDER_TARGET aTarget )
 }
 
 
+GAL_DRAW_STATS OPENGL_GAL::GetDrawStats() const
+{
+    GAL_DRAW_STATS stats;
+
+    for( VERTEX_MANAGER* manager : { m_cachedManager, m_nonCachedManager, m_overlayManager,
+                                     m_tempManager } )
+    {
+        if( manager )
+            stats += manager->GetDrawStats();
+    }
+
+    return stats;
+}
+
+
+void OPENGL_GAL::ResetDrawStats()
+{
+    for( VERTEX_MANAGER* manager : { m_cachedManager, m_nonCachedManager, m_overlayManager,
+                                     m_tempManager } )
+    {
+        if( manager )
+            manager->ResetDrawStats();
+    }
+}
+
+
 void OPENGL_GAL::StartDiffLayer()
 {
     m_currentManager->EndDrawing();
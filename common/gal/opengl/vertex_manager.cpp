@@ -280,6 +280,18 @@ void VERTEX_MANAGER::EndDrawing() const
 }
 
 
+const GAL_DRAW_STATS& VERTEX_MANAGER::GetDrawStats() const
+{
+    return m_gpu->GetDrawStats();
+}
+
+
+void VERTEX_MANAGER::ResetDrawStats()
+{
+    m_gpu->ResetDrawStats();
+}
+
+
 void VERTEX_MANAGER::putVertex( VERTEX& aTarget, GLfloat aX, GLfloat aY, GLfloat aZ ) const
 {
     // Modify the vertex according to the currently used transformations
@@ -203,6 +203,7 @@ LIB_TREE_NODE_ITEM::LIB_TREE_NODE_ITEM( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* a
     aItem->GetChooserFields( m_Fields );
 
     m_SearchTerms = aItem->GetSearchTerms();
+    m_PreparedTerms.Prepare( m_SearchTerms );
 
     m_IsRoot = aItem->IsRoot();
 
@@ -233,6 +234,7 @@ void LIB_TREE_NODE_ITEM::Update( LIB_TREE_ITEM* aItem )
     aItem->GetChooserFields( m_Fields );
 
     m_SearchTerms = aItem->GetSearchTerms();
+    m_PreparedTerms.Prepare( m_SearchTerms );
 
     m_IsRoot = aItem->IsRoot();
     m_Children.clear();
@@ -248,7 +250,7 @@ void LIB_TREE_NODE_ITEM::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxSt
     // aMatcher test is additive, but if we don't match the given term at all, it nulls out
     if( aMatcher )
     {
-        int currentScore = aMatcher->ScoreTerms( m_SearchTerms );
+        int currentScore = aMatcher->ScoreTerms( m_SearchTerms, m_PreparedTerms );
 
         // This is a hack: the second phase of search in the adapter will look for a tokenized
         // LIB_ID and send the lib part down here.  While we generally want to prune ourselves
@@ -284,6 +286,7 @@ LIB_TREE_NODE_LIBRARY::LIB_TREE_NODE_LIBRARY( LIB_TREE_NODE* aParent, wxString c
     m_LibId.SetLibNickname( aName );
 
     m_SearchTerms.emplace_back( SEARCH_TERM( aName, 8 ) );
+    m_PreparedTerms.Prepare( m_SearchTerms );
 }
 
 
@@ -319,7 +322,7 @@ void LIB_TREE_NODE_LIBRARY::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const w
     // aMatcher test is additive
     if( aMatcher )
     {
-        int ownScore = aMatcher->ScoreTerms( m_SearchTerms );
+        int ownScore = aMatcher->ScoreTerms( m_SearchTerms, m_PreparedTerms );
         m_Score += ownScore;
 
         // If we have a hit on a library, show all children in that library that pass the filter
@@ -41,6 +41,7 @@
 #include <eda_text.h> // for IsGotoPageHref
 #include <font/font.h>
 #include <core/ignore.h>
+#include <core/thread_pool.h>
 #include <macros.h>
 #include <trigo.h>
 #include <string_utils.h>
@@ -561,25 +562,17 @@ int PDF_PLOTTER::startPdfStream( int handle )
 {
     wxASSERT( m_outputFile );
     wxASSERT( !m_workFile );
-    handle = startPdfObject( handle );
+
+    // The object itself is only written once its content is compressed
+    if( handle < 0 )
+        handle = allocPdfObject();
+
+    m_streamHandle = handle;
 
     // This is guaranteed to be handle+1 but needs to be allocated since
     // you could allocate more object during stream preparation
     m_streamLengthHandle = allocPdfObject();
 
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
-    {
-        fprintf( m_outputFile,
-                 "<< /Length %d 0 R >>\n" // Length is deferred
-                 "stream\n", handle + 1 );
-    }
-    else
-    {
-        fprintf( m_outputFile,
-                 "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
-                 "stream\n", handle + 1 );
-    }
-
     // Open a temporary file to accumulate the stream
     m_workFilename = wxFileName::CreateTempFileName( "" );
     m_workFile = wxFopen( m_workFilename, wxT( "w+b" ) );
@@ -600,11 +593,11 @@ void PDF_PLOTTER::closePdfStream()
         return;
     }
 
-    // Rewind the file, read in the page stream and DEFLATE it
+    // Rewind the file and read in the page stream
     fseek( m_workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
+    std::string inbuf( stream_len, '\0' );
 
-    int rc = fread( inbuf, 1, stream_len, m_workFile );
+    int rc = fread( inbuf.data(), 1, stream_len, m_workFile );
     wxASSERT( rc == stream_len );
     ignore_unused( rc );
 
@@ -613,45 +606,81 @@ void PDF_PLOTTER::closePdfStream()
     m_workFile = nullptr;
     ::wxRemoveFile( m_workFilename );
 
-    unsigned out_count;
+    auto deflate =
+            []( const std::string& aData ) -> std::string
+            {
+                if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+                    return aData;
+
+                // NULL means memos owns the memory, but provide a hint on optimum size needed.
+                wxMemoryOutputStream memos( nullptr, std::max<size_t>( 2000, aData.size() ) );
 
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
-    {
-        out_count = stream_len;
-        fwrite( inbuf, out_count, 1, m_outputFile );
-    }
-    else
-    {
-        // NULL means memos owns the memory, but provide a hint on optimum size needed.
-        wxMemoryOutputStream    memos( nullptr, std::max( 2000l, stream_len ) ) ;
+                {
+                    /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
+                     * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
+                     * stream! (a DEFLATE stream would be generated with -15 instead of 15)
+                     * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
+                     *                    8, Z_DEFAULT_STRATEGY );
+                     */
 
-        {
-            /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-             * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-             * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-             * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-             *                    8, Z_DEFAULT_STRATEGY );
-             */
+                    wxZlibOutputStream zos( memos, ADVANCED_CFG::GetCfg().m_PDFCompressionLevel,
+                                            wxZLIB_ZLIB );
 
-            wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+                    zos.Write( aData.data(), aData.size() );
+                }   // flush the zip stream using zos destructor
 
-            zos.Write( inbuf, stream_len );
-        }   // flush the zip stream using zos destructor
+                wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
 
-        wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+                return std::string( (const char*) sb->GetBufferStart(), sb->Tell() );
+            };
 
-        out_count = sb->Tell();
-        fwrite( sb->GetBufferStart(), 1, out_count, m_outputFile );
-    }
+    // Pages are compressed concurrently; only keep about one per thread in flight so large
+    // plots don't hold every page in memory
+    thread_pool& tp = GetKiCadThreadPool();
 
-    delete[] inbuf;
-    fputs( "\nendstream\n", m_outputFile );
-    closePdfObject();
+    m_pendingStreams.push_back( { m_streamHandle, m_streamLengthHandle,
+                                  tp.submit( deflate, std::move( inbuf ) ) } );
 
-    // Writing the deferred length as an indirect object
-    startPdfObject( m_streamLengthHandle );
-    fprintf( m_outputFile, "%u\n", out_count );
-    closePdfObject();
+    writePendingStreams( tp.get_thread_count() );
+}
+
+
+void PDF_PLOTTER::writePendingStreams( size_t aMaxPending )
+{
+    wxASSERT( m_outputFile );
+    wxASSERT( !m_workFile );
+
+    while( m_pendingStreams.size() > aMaxPending )
+    {
+        PENDING_STREAM& pending = m_pendingStreams.front();
+        std::string     data = pending.m_data.get();
+
+        startPdfObject( pending.m_handle );
+
+        if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+        {
+            fprintf( m_outputFile,
+                     "<< /Length %d 0 R >>\n" // Length is deferred
+                     "stream\n", pending.m_lengthHandle );
+        }
+        else
+        {
+            fprintf( m_outputFile,
+                     "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
+                     "stream\n", pending.m_lengthHandle );
+        }
+
+        fwrite( data.data(), 1, data.size(), m_outputFile );
+        fputs( "\nendstream\n", m_outputFile );
+        closePdfObject();
+
+        // Writing the deferred length as an indirect object
+        startPdfObject( pending.m_lengthHandle );
+        fprintf( m_outputFile, "%u\n", (unsigned) data.size() );
+        closePdfObject();
+
+        m_pendingStreams.pop_front();
+    }
 }
 
 
@@ -1114,6 +1143,8 @@ bool PDF_PLOTTER::EndPlot()
     // Close the current page (often the only one)
     ClosePage();
 
+    writePendingStreams( 0 );
+
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
        is *very* involved! */
@@ -1205,7 +1236,8 @@ bool PDF_PLOTTER::EndPlot()
 
         {
             wxFFileOutputStream ffos( outputFFile );
-            wxZlibOutputStream  zos( ffos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+            wxZlibOutputStream  zos( ffos, ADVANCED_CFG::GetCfg().m_PDFCompressionLevel,
+                                     wxZLIB_ZLIB );
             wxDataOutputStream  dos( zos );
 
             WriteImageStream( image, dos, m_renderSettings->GetBackgroundColor().ToColour(),
@@ -1246,7 +1278,8 @@ bool PDF_PLOTTER::EndPlot()
 
             {
                 wxFFileOutputStream ffos( outputFFile );
-                wxZlibOutputStream  zos( ffos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+                wxZlibOutputStream  zos( ffos, ADVANCED_CFG::GetCfg().m_PDFCompressionLevel,
+                                     wxZLIB_ZLIB );
                 wxDataOutputStream  dos( zos );
 
                 WriteImageSMaskStream( image, dos );
@@ -509,6 +509,8 @@ const std::map<wxString, std::shared_ptr<NETCLASS>>& NET_SETTINGS::GetCompositeN
 
 void NET_SETTINGS::ClearNetclasses()
 {
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     m_netClasses.clear();
     m_impicitNetClasses.clear();
 }
@@ -596,6 +598,8 @@ void NET_SETTINGS::ClearNetclassPatternAssignments()
 
 void NET_SETTINGS::ClearCacheForNet( const wxString& netName )
 {
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     if( m_effectiveNetclassCache.count( netName ) )
     {
         wxString compositeNetclassName =
@@ -608,6 +612,8 @@ void NET_SETTINGS::ClearCacheForNet( const wxString& netName )
 
 void NET_SETTINGS::ClearAllCaches()
 {
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     m_effectiveNetclassCache.clear();
     m_compositeNetClasses.clear();
 }
@@ -633,12 +639,16 @@ void NET_SETTINGS::ClearNetColorAssignments()
 
 bool NET_SETTINGS::HasEffectiveNetClass( const wxString& aNetName ) const
 {
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     return m_effectiveNetclassCache.count( aNetName ) > 0;
 }
 
 
 std::shared_ptr<NETCLASS> NET_SETTINGS::GetCachedEffectiveNetClass( const wxString& aNetName ) const
 {
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     return m_effectiveNetclassCache.at( aNetName );
 }
 
@@ -683,6 +693,8 @@ std::shared_ptr<NETCLASS> NET_SETTINGS::GetEffectiveNetClass( const wxString& aN
     if( aNetName.IsEmpty() )
         return m_defaultNetClass;
 
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     // First check if we have a cached resolved netclass
     auto cacheItr = m_effectiveNetclassCache.find( aNetName );
 
@@ -772,6 +784,8 @@ std::shared_ptr<NETCLASS> NET_SETTINGS::GetEffectiveNetClass( const wxString& aN
 
 void NET_SETTINGS::RecomputeEffectiveNetclasses()
 {
+    std::lock_guard<std::mutex> lock( m_effectiveNetclassMutex );
+
     for( auto& [ncName, nc] : m_compositeNetClasses )
     {
         // Note this needs to be a copy in case we now need to add the default netclass
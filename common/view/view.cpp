@@ -978,7 +978,8 @@ struct VIEW::DRAW_ITEM_VISITOR
         useDrawPriority( aUseDrawPriority ),
         reverseDrawOrder( aReverseDrawOrder ),
         drawForcedTransparent( false ),
-        foundForcedTransparent( false )
+        foundForcedTransparent( false ),
+        drawnItems( 0 )
     {
     }
 
@@ -1003,6 +1004,8 @@ struct VIEW::DRAW_ITEM_VISITOR
         else
             view->draw( aItem, layer );
 
+        drawnItems++;
+
         return true;
     }
 
@@ -1035,6 +1038,7 @@ struct VIEW::DRAW_ITEM_VISITOR
     std::vector<VIEW_ITEM*> drawItems;
     bool drawForcedTransparent;
     bool foundForcedTransparent;
+    unsigned drawnItems;
 };
 
 
@@ -1045,6 +1049,7 @@ void VIEW::redrawRect( const BOX2I& aRect )
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
         {
             DRAW_ITEM_VISITOR drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
+            PROF_TIMER        layerTimer;
 
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
@@ -1076,6 +1081,12 @@ void VIEW::redrawRect( const BOX2I& aRect )
 
                 l->items->Query( aRect, drawFunc );
             }
+
+            if( m_frameStats.IsRecording() )
+            {
+                layerTimer.Stop();
+                m_frameStats.AddLayer( l->id, drawFunc.drawnItems, layerTimer.msecs() );
+            }
         }
     }
 }
@@ -1212,8 +1223,21 @@ void VIEW::Redraw()
     rect.Normalize();
     BOX2I recti = BOX2ISafe( rect );
 
+    // Overlay-only refreshes are not recorded; the frame is completed by the owner of the GAL
+    // once the drawing context has been flushed (see VIEW_FRAME_STATS::EndFrame())
+    if( IsTargetDirty( TARGET_CACHED ) || IsTargetDirty( TARGET_NONCACHED ) )
+        m_frameStats.BeginFrame();
+
+    PROF_TIMER redrawTimer;
+
     redrawRect( recti );
 
+    if( m_frameStats.IsRecording() )
+    {
+        redrawTimer.Stop();
+        m_frameStats.SetRedrawTime( redrawTimer.msecs() );
+    }
+
     // All targets were redrawn, so nothing is dirty
     MarkClean();
 
@@ -0,0 +1,230 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <view/view_frame_stats.h>
+#include <view/view.h>
+#include <view/view_overlay.h>
+#include <gal/color4d.h>
+#include <geometry/eda_angle.h>
+#include <math/util.h>
+
+#include <algorithm>
+
+#include <wx/ffile.h>
+#include <wx/string.h>
+
+using namespace KIGFX;
+
+
+unsigned VIEW_FRAME_RECORD::TotalItems() const
+{
+    unsigned total = 0;
+
+    for( const VIEW_LAYER_FRAME_STATS& layerStats : layers )
+        total += layerStats.items;
+
+    return total;
+}
+
+
+double VIEW_FRAME_RECORD::TotalQueryMs() const
+{
+    double total = 0.0;
+
+    for( const VIEW_LAYER_FRAME_STATS& layerStats : layers )
+        total += layerStats.queryMs;
+
+    return total;
+}
+
+
+VIEW_FRAME_STATS::VIEW_FRAME_STATS( size_t aCapacity ) :
+        m_frames( std::max<size_t>( aCapacity, 1 ) ),
+        m_first( 0 ),
+        m_count( 0 ),
+        m_frameCounter( 0 ),
+        m_enabled( false ),
+        m_recording( false )
+{
+}
+
+
+void VIEW_FRAME_STATS::BeginFrame()
+{
+    if( !m_enabled )
+        return;
+
+    m_current.frame = m_frameCounter++;
+    m_current.redrawMs = 0.0;
+    m_current.gal = GAL_DRAW_STATS();
+    m_current.layers.clear();
+    m_recording = true;
+}
+
+
+void VIEW_FRAME_STATS::AddLayer( int aLayer, unsigned aItems, double aQueryMs )
+{
+    if( !m_recording )
+        return;
+
+    VIEW_LAYER_FRAME_STATS layerStats;
+    layerStats.layer = aLayer;
+    layerStats.items = aItems;
+    layerStats.queryMs = aQueryMs;
+
+    m_current.layers.push_back( layerStats );
+}
+
+
+void VIEW_FRAME_STATS::EndFrame( const GAL_DRAW_STATS& aGalStats )
+{
+    if( !m_recording )
+        return;
+
+    m_recording = false;
+    m_current.gal = aGalStats;
+
+    size_t slot = ( m_first + m_count ) % m_frames.size();
+
+    // Swap rather than copy so the layer vectors get recycled between frames
+    std::swap( m_frames[slot], m_current );
+
+    if( m_count < m_frames.size() )
+        m_count++;
+    else
+        m_first = ( m_first + 1 ) % m_frames.size();
+}
+
+
+void VIEW_FRAME_STATS::Clear()
+{
+    m_first = 0;
+    m_count = 0;
+    m_recording = false;
+}
+
+
+const VIEW_FRAME_RECORD& VIEW_FRAME_STATS::GetFrame( size_t aIndex ) const
+{
+    wxASSERT( aIndex < m_count );
+    return m_frames[( m_first + aIndex ) % m_frames.size()];
+}
+
+
+bool VIEW_FRAME_STATS::WriteCsv( const wxString& aFileName ) const
+{
+    wxFFile file( aFileName, wxS( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    file.Write( wxS( "frame,redraw_ms,draw_calls,vertices,upload_bytes,layer,items,query_ms\n" ) );
+
+    for( size_t i = 0; i < m_count; i++ )
+    {
+        const VIEW_FRAME_RECORD& rec = GetFrame( i );
+
+        wxString frameCols = wxString::Format( wxS( "%llu,%.3f,%llu,%llu,%llu" ),
+                                               rec.frame, rec.redrawMs, rec.gal.drawCalls,
+                                               rec.gal.vertices, rec.gal.uploadBytes );
+
+        // Keep frames that did not draw any layer visible in the output
+        if( rec.layers.empty() )
+            file.Write( frameCols + wxS( ",,,\n" ) );
+
+        for( const VIEW_LAYER_FRAME_STATS& layerStats : rec.layers )
+        {
+            file.Write( frameCols + wxString::Format( wxS( ",%d,%u,%.3f\n" ), layerStats.layer,
+                                                      layerStats.items, layerStats.queryMs ) );
+        }
+    }
+
+    return file.Close();
+}
+
+
+void VIEW_FRAME_STATS::DrawOverlay( VIEW_OVERLAY& aOverlay, const VIEW& aView ) const
+{
+    aOverlay.Clear();
+
+    if( m_count == 0 )
+        return;
+
+    const VIEW_FRAME_RECORD& last = GetFrame( m_count - 1 );
+
+    double avgRedraw = 0.0;
+    double maxRedraw = 0.0;
+
+    for( size_t i = 0; i < m_count; i++ )
+    {
+        avgRedraw += GetFrame( i ).redrawMs;
+        maxRedraw = std::max( maxRedraw, GetFrame( i ).redrawMs );
+    }
+
+    avgRedraw /= m_count;
+
+    std::vector<wxString> lines;
+
+    lines.push_back( wxString::Format( wxS( "frame %llu: redraw %.2f ms (avg %.2f, max %.2f over "
+                                            "%d frames)" ),
+                                       last.frame, last.redrawMs, avgRedraw, maxRedraw,
+                                       (int) m_count ) );
+    lines.push_back( wxString::Format( wxS( "items %u, R-tree query %.2f ms" ),
+                                       last.TotalItems(), last.TotalQueryMs() ) );
+    lines.push_back( wxString::Format( wxS( "draw calls %llu, vertices %llu, uploaded %.1f kB" ),
+                                       last.gal.drawCalls, last.gal.vertices,
+                                       last.gal.uploadBytes / 1024.0 ) );
+
+    // List the most expensive layers of the last frame
+    std::vector<VIEW_LAYER_FRAME_STATS> layers = last.layers;
+
+    std::sort( layers.begin(), layers.end(),
+               []( const VIEW_LAYER_FRAME_STATS& a, const VIEW_LAYER_FRAME_STATS& b )
+               {
+                   return a.queryMs > b.queryMs;
+               } );
+
+    for( size_t i = 0; i < std::min<size_t>( layers.size(), 8 ); i++ )
+    {
+        lines.push_back( wxString::Format( wxS( "  layer %d: %u items, %.2f ms" ),
+                                           layers[i].layer, layers[i].items,
+                                           layers[i].queryMs ) );
+    }
+
+    // The overlay is drawn in world coordinates, so convert from screen space
+    const double glyphSize = aView.ToWorld( 12.0 );
+    const double lineSpacing = glyphSize * 1.5;
+    VECTOR2D     pos = aView.ToWorld( VECTOR2D( 10.0, 20.0 ) );
+    const double ySign = aView.IsMirroredY() ? -1.0 : 1.0;
+
+    aOverlay.SetIsStroke( true );
+    aOverlay.SetIsFill( false );
+    aOverlay.SetStrokeColor( COLOR4D( 1.0, 1.0, 0.0, 1.0 ) );
+    aOverlay.SetGlyphSize( VECTOR2I( KiROUND( glyphSize ), KiROUND( glyphSize ) ) );
+
+    for( const wxString& line : lines )
+    {
+        aOverlay.BitmapText( line, VECTOR2I( KiROUND( pos.x ), KiROUND( pos.y ) ), ANGLE_0 );
+        pos.y += lineSpacing * ySign;
+    }
+}
@@ -422,12 +422,23 @@ const wxString& CONNECTION_SUBGRAPH::GetNameForDriver( SCH_ITEM* aItem ) const
     if( aItem->HasCachedDriverName() )
         return aItem->GetCachedDriverName();
 
-    auto it = m_driver_name_cache.find( aItem );
+    {
+        std::lock_guard<std::mutex> lock( m_driver_name_cache_mutex );
+
+        auto it = m_driver_name_cache.find( aItem );
+
+        if( it != m_driver_name_cache.end() )
+            return it->second;
+    }
+
+    // Resolving the name may take other locks, so don't hold ours meanwhile.  If another thread
+    // cached the same name in the meantime, theirs is kept; references to the elements of an
+    // unordered_map stay valid when other elements are added.
+    wxString name = driverName( aItem );
 
-    if( it != m_driver_name_cache.end() )
-        return it->second;
+    std::lock_guard<std::mutex> lock( m_driver_name_cache_mutex );
 
-    return m_driver_name_cache.emplace( aItem, driverName( aItem ) ).first->second;
+    return m_driver_name_cache.emplace( aItem, std::move( name ) ).first->second;
 }
 
 
@@ -642,6 +653,7 @@ void CONNECTION_GRAPH::Merge( CONNECTION_GRAPH& aGraph )
     m_last_bus_code = std::max( m_last_bus_code, aGraph.m_last_bus_code );
     m_last_net_code = std::max( m_last_net_code, aGraph.m_last_net_code );
     m_last_subgraph_code = std::max( m_last_subgraph_code, aGraph.m_last_subgraph_code );
+    m_label_keys_valid = false;
 
 }
 
@@ -715,6 +727,8 @@ void CONNECTION_GRAPH::Reset()
     m_item_to_subgraph_map.clear();
     m_local_label_cache.clear();
     m_global_label_cache.clear();
+    m_label_keys.clear();
+    m_label_keys_valid = false;
     m_last_net_code = 1;
     m_last_bus_code = 1;
     m_last_subgraph_code = 1;
@@ -732,6 +746,8 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     PROF_TIMER update_items( "updateItemConnectivity" );
 
     m_sheetList = aSheetList;
+    m_screen_connectivity_cache.clear();
+    m_label_keys_valid = false;
     std::set<SCH_ITEM*> dirty_items;
 
     for( const SCH_SHEET_PATH& sheet : aSheetList )
@@ -808,6 +824,15 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
             }
         }
 
+        // Nothing changed on this sheet; its subgraphs and dangling states are still valid
+        if( !aUnconditional && items.empty() )
+        {
+            for( const auto& [ symbol, originalUnit ] : symbolsChanged )
+                symbol->SetUnit( originalUnit );
+
+            continue;
+        }
+
         m_items.reserve( m_items.size() + items.size() );
 
         updateItemConnectivity( sheet, items );
@@ -825,6 +850,8 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     m_schematic->CurrentSheet().LastScreen()->TestDanglingEnds( &m_schematic->CurrentSheet(),
                                                                 aChangedItemHandler );
 
+    m_screen_connectivity_cache.clear();
+
     for( SCH_ITEM* item : dirty_items )
         item->SetConnectivityDirty( false );
 
@@ -845,6 +872,89 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 }
 
 
+const std::vector<CONNECTION_GRAPH::LABEL_KEY>& CONNECTION_GRAPH::GetLabelKeys()
+{
+    std::lock_guard<std::mutex> lock( m_label_keys_mutex );
+
+    if( m_label_keys_valid )
+        return m_label_keys;
+
+    m_label_keys.clear();
+
+    for( const auto& [ key, subgraphs ] : m_net_code_to_subgraphs_map )
+    {
+        for( CONNECTION_SUBGRAPH* subgraph : subgraphs )
+        {
+            for( SCH_ITEM* item : subgraph->GetItems() )
+            {
+                switch( item->Type() )
+                {
+                case SCH_LABEL_T:
+                case SCH_HIER_LABEL_T:
+                case SCH_GLOBAL_LABEL_T:
+                    break;
+
+                case SCH_PIN_T:
+                    if( !static_cast<SCH_PIN*>( item )->IsGlobalPower() )
+                        continue;
+
+                    break;
+
+                default:
+                    continue;
+                }
+
+                LABEL_KEY& labelKey = m_label_keys.emplace_back();
+                labelKey.m_item = item;
+                labelKey.m_sheet = subgraph->GetSheet();
+                labelKey.m_order = m_label_keys.size() - 1;
+            }
+        }
+    }
+
+    // Resolving the shown text (text variables included) is the expensive part
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.push_loop( m_label_keys.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    LABEL_KEY& labelKey = m_label_keys[ii];
+
+                    if( labelKey.m_item->Type() == SCH_PIN_T )
+                    {
+                        SCH_PIN*    pin = static_cast<SCH_PIN*>( labelKey.m_item );
+                        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
+
+                        labelKey.m_text = symbol->GetValue( true, &labelKey.m_sheet, false );
+                    }
+                    else
+                    {
+                        SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( labelKey.m_item );
+
+                        labelKey.m_text = label->GetShownText( &labelKey.m_sheet, false );
+                    }
+
+                    labelKey.m_key = labelKey.m_text.Lower();
+                }
+            } );
+    tp.wait_for_tasks();
+
+    std::sort( m_label_keys.begin(), m_label_keys.end(),
+               []( const LABEL_KEY& a, const LABEL_KEY& b )
+               {
+                   int cmp = a.m_key.Cmp( b.m_key );
+
+                   return cmp < 0 || ( cmp == 0 && a.m_order < b.m_order );
+               } );
+
+    m_label_keys_valid = true;
+
+    return m_label_keys;
+}
+
+
 std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffectedItems(
         const std::set<SCH_ITEM*> &aItems )
 {
@@ -974,9 +1084,9 @@ void CONNECTION_GRAPH::RemoveItem( SCH_ITEM* aItem )
 void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgraphs )
 {
     wxLogTrace( ConnTrace, wxT( "Removing %zu subgraphs" ), aSubgraphs.size() );
+    m_label_keys_valid = false;
     std::sort( m_driver_subgraphs.begin(), m_driver_subgraphs.end() );
     std::sort( m_subgraphs.begin(), m_subgraphs.end() );
-    std::set<int> codes_to_remove;
 
     for( auto& el : m_sheet_to_subgraphs_map )
     {
@@ -1076,10 +1186,7 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
              it != m_net_code_to_subgraphs_map.end(); )
         {
             if( remove_sg( it ) )
-            {
-                codes_to_remove.insert( it->first.Netcode );
                 it = m_net_code_to_subgraphs_map.erase( it );
-            }
             else
                 ++it;
         }
@@ -1104,21 +1211,8 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
 
     }
 
-    for( auto it = m_net_name_to_code_map.begin(); it != m_net_name_to_code_map.end(); )
-    {
-        if( codes_to_remove.contains( it->second ) )
-            it = m_net_name_to_code_map.erase( it );
-        else
-            ++it;
-    }
-
-    for( auto it = m_bus_name_to_code_map.begin(); it != m_bus_name_to_code_map.end(); )
-    {
-        if( codes_to_remove.contains( it->second ) )
-            it = m_bus_name_to_code_map.erase( it );
-        else
-            ++it;
-    }
+    // The name to code maps are deliberately left alone: the graph rebuilt from the extracted
+    // items inherits them (see SetLastCodes()), so nets that survive the edit keep their codes.
 
     for( CONNECTION_SUBGRAPH* sg : aSubgraphs )
     {
@@ -1136,6 +1230,25 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 aSheet.Last()->GetFileName(), aItemList.size() );
     std::map<VECTOR2I, std::vector<SCH_ITEM*>> connection_map;
 
+    // Repeated instances of a screen (multichannel designs) share the graphical connectivity,
+    // as long as the symbols use the same units.
+    std::vector<int> units;
+
+    for( SCH_ITEM* item : aItemList )
+    {
+        if( item->Type() == SCH_SYMBOL_T )
+            units.push_back( static_cast<SCH_SYMBOL*>( item )->GetUnit() );
+    }
+
+    SCREEN_CONNECTIVITY* shared = nullptr;
+    auto                 cacheIt = m_screen_connectivity_cache.find( aSheet.LastScreen() );
+
+    if( cacheIt != m_screen_connectivity_cache.end() && cacheIt->second.m_itemList == aItemList
+            && cacheIt->second.m_units == units )
+    {
+        shared = &cacheIt->second;
+    }
+
     auto updatePin = [&]( SCH_PIN* aPin, SCH_CONNECTION* aConn )
     {
         aConn->SetType( CONNECTION_TYPE::NET );
@@ -1197,9 +1310,14 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
             case SCH_BUS_BUS_ENTRY_T:
                 conn->SetType( CONNECTION_TYPE::BUS );
 
-                // clean previous (old) links:
-                static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[0] = nullptr;
-                static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
+                // clean previous (old) links, unless they were just set up for another
+                // instance of this screen:
+                if( !shared )
+                {
+                    static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[0] = nullptr;
+                    static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
+                }
+
                 break;
 
             case SCH_PIN_T:
@@ -1213,7 +1331,9 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 conn->SetType( CONNECTION_TYPE::NET );
 
                 // clean previous (old) link:
-                static_cast<SCH_BUS_WIRE_ENTRY*>( item )->m_connected_bus_item = nullptr;
+                if( !shared )
+                    static_cast<SCH_BUS_WIRE_ENTRY*>( item )->m_connected_bus_item = nullptr;
+
                 break;
 
             default:
@@ -1225,6 +1345,19 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         }
     }
 
+    if( shared )
+    {
+        for( const auto& [ item, connected ] : shared->m_links )
+        {
+            for( SCH_ITEM* connected_item : connected )
+                item->AddConnectionTo( aSheet, connected_item );
+        }
+
+        return;
+    }
+
+    std::set<SCH_ITEM*> linked_items;
+
     for( const auto& it : connection_map )
     {
         std::vector<SCH_ITEM*> connection_vec = it.second;
@@ -1277,6 +1410,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                         std::lock_guard<std::mutex> lock( update_mutex );
                         bus_entry->AddConnectionTo( aSheet, busLine );
                         busLine->AddConnectionTo( aSheet, bus_entry );
+                        linked_items.insert( busLine );
                     }
                 }
             }
@@ -1353,6 +1487,22 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                         update_lambda( connection_vec[ii] );
                 });
         tp.wait_for_tasks();
+
+        linked_items.insert( connection_vec.begin(), connection_vec.end() );
+    }
+
+    SCREEN_CONNECTIVITY& cache = m_screen_connectivity_cache[ aSheet.LastScreen() ];
+
+    cache.m_itemList = aItemList;
+    cache.m_units = std::move( units );
+    cache.m_links.clear();
+
+    for( SCH_ITEM* item : linked_items )
+    {
+        const SCH_ITEM_VEC& connected = item->ConnectedItems( aSheet );
+
+        if( !connected.empty() )
+            cache.m_links.emplace_back( item, connected );
     }
 }
 
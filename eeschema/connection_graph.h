@@ -44,6 +44,7 @@ class SCHEMATIC;
 class SCH_EDIT_FRAME;
 class SCH_HIERLABEL;
 class SCH_PIN;
+class SCH_SCREEN;
 class SCH_SHEET_PIN;
 
 
@@ -293,6 +294,10 @@ private:
     /// A cache of escaped netnames from schematic items.
     mutable std::unordered_map<SCH_ITEM*, wxString> m_driver_name_cache;
 
+    /// Guards m_driver_name_cache, which is filled when names are first asked for, possibly
+    /// by several threads at once.
+    mutable std::mutex m_driver_name_cache_mutex;
+
     /// Fully-resolved driver for the subgraph (might not exist in this subgraph).
     SCH_ITEM* m_driver;
 
@@ -368,11 +373,17 @@ public:
         m_schematic = aSchematic;
     }
 
+    /**
+     * Continue the numbering of \a aOther, reusing its net and bus codes for names that are
+     * already known so that codes stay stable across incremental updates.
+     */
     void SetLastCodes( const CONNECTION_GRAPH* aOther )
     {
         m_last_net_code = aOther->m_last_net_code;
         m_last_bus_code = aOther->m_last_bus_code;
         m_last_subgraph_code = aOther->m_last_subgraph_code;
+        m_net_name_to_code_map = aOther->m_net_name_to_code_map;
+        m_bus_name_to_code_map = aOther->m_bus_name_to_code_map;
     }
 
     /**
@@ -413,6 +424,28 @@ public:
 
     const NET_MAP& GetNetMap() const { return m_net_code_to_subgraphs_map; }
 
+    /**
+     * The shown text of a net label or global power symbol, as compared by the similar
+     * labels ERC check.
+     */
+    struct LABEL_KEY
+    {
+        wxString       m_text;    ///< Shown text on m_sheet
+        wxString       m_key;     ///< m_text in lower case
+        SCH_ITEM*      m_item;    ///< The label, or the power pin of the symbol
+        SCH_SHEET_PATH m_sheet;
+        size_t         m_order;   ///< Position of the item in the net map iteration
+    };
+
+    /**
+     * Return the label keys of all labels and global power pins of the graph, sorted by key
+     * and then by order.
+     *
+     * The keys are computed on the first call after the graph has changed and cached until
+     * the next change.
+     */
+    const std::vector<LABEL_KEY>& GetLabelKeys();
+
     /**
      * Return the subgraph for a given net name on a given sheet.
      *
@@ -447,7 +480,8 @@ public:
 
     /**
      * For a set of items, this will remove the connected items and their
-     * associated data including subgraphs and generated codes from the connection graph.
+     * associated data including subgraphs from the connection graph.  The net and bus codes
+     * are kept so that they can be reused when the items are added back.
      *
      * @param aItems A vector of items whose presence should be removed from the graph.
      * @return The full set of all items associated with the input items that were removed.
@@ -509,6 +543,10 @@ private:
      *
      * As a side effect, items are loaded into m_items for BuildConnectionGraph().
      *
+     * The graphical connectivity only depends on the screen contents, so when a screen is
+     * used by several sheet paths with the same items and symbol units, the second phase is
+     * run once and its results are copied to the other paths.
+     *
      * @param aSheet is the path to the sheet of all items in the list.
      * @param aItemList is a list of items to consider.
      */
@@ -776,6 +814,24 @@ private:
 
     NET_MAP m_net_code_to_subgraphs_map;
 
+    /// Graphical connectivity of a screen, as computed by updateItemConnectivity() for the
+    /// first sheet path using it.  Only valid during Recalculate().
+    struct SCREEN_CONNECTIVITY
+    {
+        std::vector<SCH_ITEM*> m_itemList;    ///< Items passed to updateItemConnectivity()
+        std::vector<int>       m_units;       ///< Selected unit of each symbol in m_itemList
+
+        ///< Connected items of each item, for the first sheet path
+        std::vector<std::pair<SCH_ITEM*, SCH_ITEM_VEC>> m_links;
+    };
+
+    std::unordered_map<SCH_SCREEN*, SCREEN_CONNECTIVITY> m_screen_connectivity_cache;
+
+    /// Cache for GetLabelKeys(), invalidated whenever subgraphs are added or removed.
+    std::vector<LABEL_KEY> m_label_keys;
+    bool                   m_label_keys_valid = false;
+    std::mutex             m_label_keys_mutex;
+
     int m_last_net_code;
 
     int m_last_bus_code;
@@ -1176,11 +1176,20 @@ void InvokeSchEditSymbolLibTable( KIWAY* aKiway, wxWindow *aParent )
     dlg.InstallPanel( new PANEL_SYM_LIB_TABLE( &dlg, &aKiway->Prj(), globalTable, globalTablePath,
                                                projectTable, projectTableFn.GetFullPath() ) );
 
+    auto* schEditor = (SCH_EDIT_FRAME*) aKiway->Player( FRAME_SCH, false );
+
+    // The tables are edited in place, so the background loading must not be using them
+    if( schEditor )
+        schEditor->CancelLibraryPreload();
+
     if( dlg.ShowModal() == wxID_CANCEL )
     {
         if( symbolEditor )
             symbolEditor->ThawLibraryTree();
 
+        if( schEditor )
+            schEditor->StartLibraryPreload();
+
         return;
     }
 
@@ -1219,4 +1228,8 @@ void InvokeSchEditSymbolLibTable( KIWAY* aKiway, wxWindow *aParent )
     aKiway->ExpressMail( FRAME_SCH, MAIL_RELOAD_LIB, payload );
     aKiway->ExpressMail( FRAME_SCH_SYMBOL_EDITOR, MAIL_RELOAD_LIB, payload );
     aKiway->ExpressMail( FRAME_SCH_VIEWER, MAIL_RELOAD_LIB, payload );
+
+    // Read the libraries of the edited tables
+    if( schEditor )
+        schEditor->StartLibraryPreload();
 }
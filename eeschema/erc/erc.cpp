@@ -24,6 +24,8 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <numeric>
 
 #include "connection_graph.h"
@@ -54,6 +56,7 @@
 #include <sim/sim_lib_mgr.h>
 #include <progress_reporter.h>
 #include <kiway.h>
+#include <core/thread_pool.h>
 
 
 /* ERC tests :
@@ -132,6 +135,20 @@ const std::set<ELECTRICAL_PINTYPE> DrivenPinTypes =
             ELECTRICAL_PINTYPE::PT_POWER_IN
         };
 
+// When set, markers created by the tests running on the current thread are collected here
+// instead of being added to their screens.  See ERC_TESTER::RunTests().
+static thread_local std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>* g_pendingMarkers = nullptr;
+
+
+void ERC_TESTER::addMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    if( g_pendingMarkers )
+        g_pendingMarkers->emplace_back( aScreen, aMarker );
+    else
+        aScreen->Append( aMarker );
+}
+
+
 extern void CheckDuplicatePins( LIB_SYMBOL* aSymbol, std::vector<wxString>& aMessages,
                                 UNITS_PROVIDER* aUnitsProvider );
 
@@ -165,7 +182,7 @@ int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
                         ercItem->SetItems( sheet, test_item );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, sheet->GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     err_count++;
@@ -205,7 +222,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( warningExpr.GetMatch( text, 1 ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
 
                 if( errorExpr.Matches( text ) )
@@ -217,7 +234,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( errorExpr.GetMatch( text, 1 ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
             };
 
@@ -251,7 +268,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -279,7 +296,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                     VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                     SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-                                    screen->Append( marker );
+                                    addMarker( screen, marker );
                                 }
 
                                testAssertion( symbol, sheet, screen, textItem->GetText() );
@@ -299,7 +316,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                     VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                     SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-                                    screen->Append( marker );
+                                    addMarker( screen, marker );
                                 }
 
                                testAssertion( symbol, sheet, screen, textboxItem->GetText() );
@@ -317,7 +334,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -336,7 +353,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -354,7 +371,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
                 }
             }
@@ -367,7 +384,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, text->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
 
                 testAssertion( text, sheet, screen, text->GetText() );
@@ -381,7 +398,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, textBox->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
 
                 testAssertion( textBox, sheet, screen, textBox->GetText() );
@@ -399,7 +416,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     erc->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( erc, text->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
             }
         }
@@ -438,7 +455,7 @@ int ERC_TESTER::TestConflictingBusAliases()
                     ercItem->SetErrorMessage( msg );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, VECTOR2I() );
-                    test->GetParent()->Append( marker );
+                    addMarker( test->GetParent(), marker );
 
                     ++err_count;
                 }
@@ -502,7 +519,7 @@ int ERC_TESTER::TestMultiunitFootprints()
                 ercItem->SetItems( unit, secondUnit );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, secondUnit->GetPosition() );
-                secondRef.GetSheetPath().LastScreen()->Append( marker );
+                addMarker( secondRef.GetSheetPath().LastScreen(), marker );
 
                 ++errors;
             }
@@ -565,7 +582,7 @@ int ERC_TESTER::TestMissingUnits()
                     ercItem->SetItemsSheetPaths( base_ref.GetSheetPath() );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, unit->GetPosition() );
-                    base_ref.GetSheetPath().LastScreen()->Append( marker );
+                    addMarker( base_ref.GetSheetPath().LastScreen(), marker );
 
                     ++errors;
                 };
@@ -668,7 +685,7 @@ int ERC_TESTER::TestMissingNetclasses()
                                                             netclass ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             };
 
     for( const SCH_SHEET_PATH& sheet : m_sheetList )
@@ -749,7 +766,7 @@ int ERC_TESTER::TestLabelMultipleWires()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -803,7 +820,7 @@ int ERC_TESTER::TestFourWayJunction()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -872,7 +889,7 @@ int ERC_TESTER::TestNoConnectPins()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -998,7 +1015,7 @@ int ERC_TESTER::TestPinToPin()
                                               ElectricalPinTypeGetText( testType ) ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, refPin.Pin()->GetPosition() );
-                    pinToScreenMap[refPin.Pin()]->Append( marker );
+                    addMarker( pinToScreenMap[refPin.Pin()], marker );
                     errors++;
                 }
             }
@@ -1017,7 +1034,7 @@ int ERC_TESTER::TestPinToPin()
                 ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
+                addMarker( pinToScreenMap[needsDriver.Pin()], marker );
                 errors++;
             }
         }
@@ -1072,7 +1089,7 @@ int ERC_TESTER::TestMultUnitPinConflicts()
                         ercItem->SetItemsSheetPaths( sheet, sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        sheet.LastScreen()->Append( marker );
+                        addMarker( sheet.LastScreen(), marker );
                         errors += 1;
                     }
                 }
@@ -1128,7 +1145,7 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
                 ercItem->SetItemsSheetPaths( globalItem.second, localItem.second );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, globalItem.first->GetPosition() );
-                globalItem.second.LastScreen()->Append( marker );
+                addMarker( globalItem.second.LastScreen(), marker );
 
                 errCount++;
             }
@@ -1142,106 +1159,60 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
 int ERC_TESTER::TestSimilarLabels()
 {
     int errors = 0;
-    std::unordered_map<wxString, std::tuple<wxString, SCH_ITEM*, SCH_SHEET_PATH>> generalMap;
-
-    auto logError = [&]( const wxString& normalized, SCH_ITEM* item, const SCH_SHEET_PATH& sheet )
-    {
-        auto& [otherText, otherItem, otherSheet] = generalMap.at( normalized );
-        ERCE_T typeOfWarning = ERCE_SIMILAR_LABELS;
-
-        if( item->Type() == SCH_PIN_T && otherItem->Type() == SCH_PIN_T )
-        {
-            //Two Pins
-            typeOfWarning = ERCE_SIMILAR_POWER;
-        }
-        else if( item->Type() == SCH_PIN_T || otherItem->Type() == SCH_PIN_T )
-        {
-            //Pin and Label
-            typeOfWarning = ERCE_SIMILAR_LABEL_AND_POWER;
-        }
-        else
-        {
-            //Two Labels
-            typeOfWarning = ERCE_SIMILAR_LABELS;
-        }
-
-        std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( typeOfWarning );
-        ercItem->SetItems( item, otherItem );
-        ercItem->SetSheetSpecificPath( sheet );
-        ercItem->SetItemsSheetPaths( sheet, otherSheet );
 
-        SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-        sheet.LastScreen()->Append( marker );
-    };
+    // Labels differing only in case end up next to each other, the first one of each run
+    // being the reference the others are compared against.
+    const std::vector<CONNECTION_GRAPH::LABEL_KEY>& keys =
+            m_schematic->ConnectionGraph()->GetLabelKeys();
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
-    {
-        for( CONNECTION_SUBGRAPH* subgraph : net.second )
-        {
-            const SCH_SHEET_PATH& sheet = subgraph->GetSheet();
-
-            for( SCH_ITEM* item : subgraph->GetItems() )
+    auto logError =
+            [&]( const CONNECTION_GRAPH::LABEL_KEY& aLabel,
+                 const CONNECTION_GRAPH::LABEL_KEY& aOther )
             {
-                switch( item->Type() )
+                SCH_ITEM* item = aLabel.m_item;
+                SCH_ITEM* otherItem = aOther.m_item;
+                ERCE_T    typeOfWarning = ERCE_SIMILAR_LABELS;
+
+                if( item->Type() == SCH_PIN_T && otherItem->Type() == SCH_PIN_T )
                 {
-                case SCH_LABEL_T:
-                case SCH_HIER_LABEL_T:
-                case SCH_GLOBAL_LABEL_T:
+                    //Two Pins
+                    typeOfWarning = ERCE_SIMILAR_POWER;
+                }
+                else if( item->Type() == SCH_PIN_T || otherItem->Type() == SCH_PIN_T )
                 {
-                    SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
-                    wxString        unnormalized = label->GetShownText( &sheet, false );
-                    wxString        normalized = unnormalized.Lower();
-
-                    if( !generalMap.count( normalized ) )
-                    {
-                        generalMap[normalized] = std::make_tuple( unnormalized, label, sheet );
-                    }
-
-                    auto& [otherText, otherItem, otherSheet] = generalMap.at( normalized );
-
-                    if( unnormalized != otherText )
-                    {
-                        logError( normalized, label, sheet );
-                        errors += 1;
-                    }
-
-                    break;
+                    //Pin and Label
+                    typeOfWarning = ERCE_SIMILAR_LABEL_AND_POWER;
                 }
-                case SCH_PIN_T:
+                else
                 {
-                    SCH_PIN* pin = static_cast<SCH_PIN*>( item );
-
-                    if( !pin->IsGlobalPower() )
-                    {
-                        continue;
-                    }
-
-                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
-                    wxString    unnormalized = symbol->GetValue( true, &sheet, false );
-                    wxString    normalized = unnormalized.Lower();
-
-                    if( !generalMap.count( normalized ) )
-                    {
-                        generalMap[normalized] = std::make_tuple( unnormalized, pin, sheet );
-                    }
+                    //Two Labels
+                    typeOfWarning = ERCE_SIMILAR_LABELS;
+                }
 
-                    auto& [otherText, otherItem, otherSheet] = generalMap.at( normalized );
+                std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( typeOfWarning );
+                ercItem->SetItems( item, otherItem );
+                ercItem->SetSheetSpecificPath( aLabel.m_sheet );
+                ercItem->SetItemsSheetPaths( aLabel.m_sheet, aOther.m_sheet );
 
-                    if( unnormalized != otherText )
-                    {
-                        logError( normalized, pin, sheet );
-                        errors += 1;
-                    }
+                SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
+                addMarker( aLabel.m_sheet.LastScreen(), marker );
+            };
 
-                    break;
-                }
+    const CONNECTION_GRAPH::LABEL_KEY* reference = nullptr;
 
-                default:
-                    break;
-                }
-            }
+    for( const CONNECTION_GRAPH::LABEL_KEY& labelKey : keys )
+    {
+        if( !reference || reference->m_key != labelKey.m_key )
+        {
+            reference = &labelKey;
+        }
+        else if( labelKey.m_text != reference->m_text )
+        {
+            logError( labelKey, *reference );
+            errors += 1;
         }
     }
+
     return errors;
 }
 
@@ -1355,7 +1326,7 @@ int ERC_TESTER::TestLibSymbolIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            addMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1435,7 +1406,7 @@ int ERC_TESTER::TestFootprintLinkIssues( KIFACE* aCvPcb, PROJECT* aProject )
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            addMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1498,7 +1469,7 @@ int ERC_TESTER::TestFootprintFilters()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            addMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1561,7 +1532,7 @@ int ERC_TESTER::TestOffGridEndpoints()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            addMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1614,7 +1585,7 @@ int ERC_TESTER::TestSimModelIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            addMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1661,38 +1632,33 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
 
     m_schematic->ConnectionGraph()->RunERC();
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking units..." ) );
+    // The remaining tests only read the schematic, apart from the markers they create.  Those
+    // not relying on external libraries run concurrently, each collecting its markers, which
+    // are then added to the screens in the order of the list below so the result doesn't
+    // depend on the scheduling.
+    std::vector<std::function<void()>> tests;
 
     // Test is all units of each multiunit symbol have the same footprint assigned.
     if( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_FP ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking footprints..." ) );
-
-        TestMultiunitFootprints();
-    }
+        tests.emplace_back( [this]() { TestMultiunitFootprints(); } );
 
     if( m_settings.IsTestEnabled( ERCE_MISSING_UNIT )
         || m_settings.IsTestEnabled( ERCE_MISSING_INPUT_PIN )
         || m_settings.IsTestEnabled( ERCE_MISSING_POWER_INPUT_PIN )
         || m_settings.IsTestEnabled( ERCE_MISSING_BIDI_PIN ) )
     {
-        TestMissingUnits();
+        tests.emplace_back( [this]() { TestMissingUnits(); } );
     }
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking pins..." ) );
-
     if( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ) )
-        TestMultUnitPinConflicts();
+        tests.emplace_back( [this]() { TestMultUnitPinConflicts(); } );
 
     // Test pins on each net against the pin connection table
     if( m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
         || m_settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
         || m_settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN ) )
     {
-        TestPinToPin();
+        tests.emplace_back( [this]() { TestPinToPin(); } );
     }
 
     // Test similar labels (i;e. labels which are identical when
@@ -1702,92 +1668,100 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         || m_settings.IsTestEnabled( ERCE_SIMILAR_LABEL_AND_POWER )
         || m_settings.IsTestEnabled( ERCE_SAME_LOCAL_GLOBAL_LABEL ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking labels..." ) );
+        // Resolve the label texts up front; this uses the thread pool itself
+        m_schematic->ConnectionGraph()->GetLabelKeys();
 
-        TestSimilarLabels();
-        TestSameLocalGlobalLabel();
+        tests.emplace_back( [this]() { TestSimilarLabels(); } );
+        tests.emplace_back( [this]() { TestSameLocalGlobalLabel(); } );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for unresolved variables..." ) );
+    if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
+        tests.emplace_back( [this]() { TestNoConnectPins(); } );
 
-        TestTextVars( aDrawingSheet );
-    }
+    if( m_settings.IsTestEnabled( ERCE_FOOTPRINT_FILTERS ) )
+        tests.emplace_back( [this]() { TestFootprintFilters(); } );
 
-    if( m_settings.IsTestEnabled( ERCE_SIMULATION_MODEL ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking SPICE models..." ) );
+    if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
+        tests.emplace_back( [this]() { TestOffGridEndpoints(); } );
 
-        TestSimModelIssues();
-    }
+    if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
+        tests.emplace_back( [this]() { TestFourWayJunction(); } );
 
-    if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking no connect pins for connections..." ) );
+    if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
+        tests.emplace_back( [this]() { TestLabelMultipleWires(); } );
 
-        TestNoConnectPins();
-    }
+    if( m_settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
+        tests.emplace_back( [this]() { TestMissingNetclasses(); } );
 
-    if( m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES )
-        || m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_MISMATCH ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for library symbol issues..." ) );
+    if( aProgressReporter )
+        aProgressReporter->AdvancePhase( _( "Checking pins, labels and wires..." ) );
 
-        TestLibSymbolIssues();
+    std::vector<std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>> markers( tests.size() );
+    std::vector<std::future<void>>                                returns( tests.size() );
+    thread_pool&                                                  tp = GetKiCadThreadPool();
+
+    for( size_t ii = 0; ii < tests.size(); ++ii )
+    {
+        returns[ii] = tp.submit(
+                [&tests, &markers, ii]()
+                {
+                    g_pendingMarkers = &markers[ii];
+                    tests[ii]();
+                    g_pendingMarkers = nullptr;
+                } );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_FOOTPRINT_LINK_ISSUES ) && aCvPcb )
+    for( const std::future<void>& ret : returns )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for footprint link issues..." ) );
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
 
-        TestFootprintLinkIssues( aCvPcb, aProject );
+        while( status != std::future_status::ready )
+        {
+            if( aProgressReporter )
+                aProgressReporter->KeepRefreshing();
+
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        }
     }
 
-    if( m_settings.IsTestEnabled( ERCE_FOOTPRINT_FILTERS ) )
+    for( const std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>& testMarkers : markers )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking footprint assignments against footprint filters..." ) );
-
-        TestFootprintFilters();
+        for( const auto& [ screen, marker ] : testMarkers )
+            screen->Append( marker );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
+    // These tests load models or libraries, which isn't thread-safe
+    if( m_settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ) )
     {
         if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for off grid pins and wires..." ) );
+            aProgressReporter->AdvancePhase( _( "Checking for unresolved variables..." ) );
 
-        TestOffGridEndpoints();
+        TestTextVars( aDrawingSheet );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
+    if( m_settings.IsTestEnabled( ERCE_SIMULATION_MODEL ) )
     {
         if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for four way junctions..." ) );
+            aProgressReporter->AdvancePhase( _( "Checking SPICE models..." ) );
 
-        TestFourWayJunction();
+        TestSimModelIssues();
     }
 
-    if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
+    if( m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES )
+        || m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_MISMATCH ) )
     {
         if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for labels on more than one wire..." ) );
+            aProgressReporter->AdvancePhase( _( "Checking for library symbol issues..." ) );
 
-        TestLabelMultipleWires();
+        TestLibSymbolIssues();
     }
 
-    if( m_settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
+    if( m_settings.IsTestEnabled( ERCE_FOOTPRINT_LINK_ISSUES ) && aCvPcb )
     {
         if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for undefined netclasses..." ) );
+            aProgressReporter->AdvancePhase( _( "Checking for footprint link issues..." ) );
 
-        TestMissingNetclasses();
+        TestFootprintLinkIssues( aCvPcb, aProject );
     }
 
     m_schematic->ResolveERCExclusionsPostUpdate();
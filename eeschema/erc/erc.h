@@ -182,6 +182,12 @@ public:
     void RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aEditFrame,
                    KIFACE* aCvPcb, PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter );
 
+private:
+    /**
+     * Add \a aMarker to \a aScreen, or defer it when the test runs concurrently with others.
+     */
+    void addMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker );
+
 private:
     SCHEMATIC*                   m_schematic;
     ERC_SETTINGS&                m_settings;
@@ -56,6 +56,7 @@
 #include <schematic.h>
 #include <settings/settings_manager.h>
 #include <sim/simulator_frame.h>
+#include <symbol_lib_preloader.h>
 #include <tool/actions.h>
 #include <tool/tool_manager.h>
 #include <tools/sch_editor_control.h>
@@ -146,6 +147,7 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
 
     // unload current project file before loading new
     {
+        m_libPreloader->Cancel();
         ClearUndoRedoList();
         ClearRepeatItemsList();
         SetScreen( nullptr );
@@ -610,6 +612,9 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
     if( GetCanvas() )
         GetCanvas()->DisplaySheet( GetCurrentSheet().LastScreen() );
 
+    // Load the symbol libraries in the background so that they are ready when first used
+    StartLibraryPreload();
+
     return true;
 }
 
@@ -1311,6 +1316,9 @@ bool SCH_EDIT_FRAME::importFile( const wxString& aFileName, int aFileType,
     wxCommandEvent changingEvt( EDA_EVT_SCHEMATIC_CHANGING );
     ProcessEventLocally( changingEvt );
 
+    // The importers replace the project symbol library table
+    m_libPreloader->Cancel();
+
     switch( fileType )
     {
     case SCH_IO_MGR::SCH_ALTIUM:
@@ -1442,6 +1450,8 @@ bool SCH_EDIT_FRAME::importFile( const wxString& aFileName, int aFileType,
         break;
     }
 
+    StartLibraryPreload();
+
     return true;
 }
 
@@ -52,6 +52,7 @@
 #include <core/profile.h>
 #include <project/project_file.h>
 #include <project/net_settings.h>
+#include <project_sch.h>
 #include <python_scripting.h>
 #include <sch_edit_frame.h>
 #include <symbol_chooser_frame.h>
@@ -63,6 +64,7 @@
 #include <settings/settings_manager.h>
 #include <advanced_config.h>
 #include <sim/simulator_frame.h>
+#include <symbol_lib_preloader.h>
 #include <tool/action_manager.h>
 #include <tool/action_toolbar.h>
 #include <tool/common_control.h>
@@ -157,6 +159,7 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
     m_findReplaceDialog = nullptr;
 
     m_findReplaceData = std::make_unique<SCH_SEARCH_DATA>();
+    m_libPreloader = std::make_unique<SYMBOL_LIB_PRELOADER>();
 
     // Give an icon
     wxIcon icon;
@@ -438,6 +441,9 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
 SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
 {
+    // The preload uses the project's symbol library table
+    m_libPreloader->Cancel();
+
 #ifdef KICAD_IPC_API
     Pgm().GetApiServer().DeregisterHandler( m_apiHandler.get() );
     wxTheApp->Unbind( EDA_EVT_PLUGIN_AVAILABILITY_CHANGED,
@@ -2111,6 +2117,18 @@ std::unique_ptr<GRID_HELPER> SCH_EDIT_FRAME::MakeGridHelper()
 }
 
 
+void SCH_EDIT_FRAME::StartLibraryPreload()
+{
+    m_libPreloader->Start( PROJECT_SCH::SchSymbolLibTable( &Prj() ), this );
+}
+
+
+void SCH_EDIT_FRAME::CancelLibraryPreload()
+{
+    m_libPreloader->Cancel();
+}
+
+
 void SCH_EDIT_FRAME::CommonSettingsChanged( bool aEnvVarsChanged, bool aTextVarsChanged )
 {
     SCH_BASE_FRAME::CommonSettingsChanged( aEnvVarsChanged, aTextVarsChanged );
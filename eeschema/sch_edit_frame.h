@@ -65,6 +65,7 @@ class DIALOG_SCH_FIND;
 class RESCUER;
 class HIERARCHY_PANE;
 class API_HANDLER_SCH;
+class SYMBOL_LIB_PRELOADER;
 
 
 /// Schematic search type used by the socket link with Pcbnew
@@ -821,6 +822,17 @@ public:
      */
     void RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FLAGS aCleanupFlags );
 
+    /**
+     * Start loading the symbol libraries of the project in the background.
+     */
+    void StartLibraryPreload();
+
+    /**
+     * Stop loading symbol libraries in the background.  Must be called before the symbol
+     * library table is modified or replaced, and followed by StartLibraryPreload() once done.
+     */
+    void CancelLibraryPreload();
+
     /**
      * Called after the preferences dialog is run.
      */
@@ -1107,6 +1119,8 @@ private:
 
     DESIGN_BLOCK_PANE* m_designBlocksPane;
 
+    std::unique_ptr<SYMBOL_LIB_PRELOADER> m_libPreloader;
+
 #ifdef KICAD_IPC_API
     std::unique_ptr<API_HANDLER_SCH> m_apiHandler;
 #endif
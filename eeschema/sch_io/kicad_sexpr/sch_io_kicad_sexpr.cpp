@@ -1620,6 +1620,39 @@ void SCH_IO_KICAD_SEXPR::cacheLib( const wxString& aLibraryFileName,
 }
 
 
+std::unique_ptr<SCH_IO_LIB_CACHE>
+SCH_IO_KICAD_SEXPR::ParseLibraryCache( const wxString& aLibraryPath ) const
+{
+#if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
+    // DSNLEXER reads numbers with strtod() with these compilers, which needs the C locale
+    return nullptr;
+#else
+    auto cache = std::make_unique<SCH_IO_KICAD_SEXPR_LIB_CACHE>( aLibraryPath );
+
+    cache->Parse();
+    return cache;
+#endif
+}
+
+
+void SCH_IO_KICAD_SEXPR::AdoptLibraryCache( const wxString& aLibraryPath,
+                                            std::unique_ptr<SCH_IO_LIB_CACHE> aCache )
+{
+    // Symbols of the current cache may be in use
+    if( m_cache && m_cache->IsFile( aLibraryPath ) && !m_cache->IsFileChanged() )
+        return;
+
+    auto cache = dynamic_cast<SCH_IO_KICAD_SEXPR_LIB_CACHE*>( aCache.get() );
+
+    if( !cache || !cache->IsFile( aLibraryPath ) )
+        return;
+
+    delete m_cache;
+    m_cache = cache;
+    aCache.release();
+}
+
+
 bool SCH_IO_KICAD_SEXPR::isBuffering( const std::map<std::string, UTF8>* aProperties )
 {
     return ( aProperties && aProperties->contains( SCH_IO_KICAD_SEXPR::PropBuffering ) );
@@ -125,6 +125,11 @@ public:
     void SaveLibrary( const wxString& aLibraryPath,
                       const std::map<std::string, UTF8>* aProperties = nullptr ) override;
 
+    std::unique_ptr<SCH_IO_LIB_CACHE>
+    ParseLibraryCache( const wxString& aLibraryPath ) const override;
+    void AdoptLibraryCache( const wxString& aLibraryPath,
+                            std::unique_ptr<SCH_IO_LIB_CACHE> aCache ) override;
+
     bool IsLibraryWritable( const wxString& aLibraryPath ) override;
 
     void GetAvailableSymbolFields( std::vector<wxString>& aNames ) override;
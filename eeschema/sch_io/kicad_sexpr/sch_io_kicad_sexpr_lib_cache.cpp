@@ -48,6 +48,16 @@ SCH_IO_KICAD_SEXPR_LIB_CACHE::~SCH_IO_KICAD_SEXPR_LIB_CACHE()
 
 
 void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
+{
+    // The current locale must use period as the decimal point.
+    // Yes, we did this earlier, but it's sadly not thread-safe.
+    LOCALE_IO toggle;
+
+    Parse();
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::Parse()
 {
     if( !m_libFileName.FileExists() )
     {
@@ -59,10 +69,6 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
                  wxString::Format( "Cannot use relative file paths in sexpr plugin to "
                                    "open library '%s'.", m_libFileName.GetFullPath() ) );
 
-    // The current locale must use period as the decimal point.
-    // Yes, we did this earlier, but it's sadly not thread-safe.
-    LOCALE_IO toggle;
-
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
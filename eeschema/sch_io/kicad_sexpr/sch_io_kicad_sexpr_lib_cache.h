@@ -49,6 +49,12 @@ public:
 
     void Load() override;
 
+    /**
+     * Same as Load(), without switching to the C locale.  Only valid when the parser reads
+     * numbers independently of the locale, see SCH_IO_KICAD_SEXPR::ParseLibraryCache().
+     */
+    void Parse();
+
     void DeleteSymbol( const wxString& aName ) override;
 
     static void SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter, int aNestLevel = 0,
@@ -24,6 +24,7 @@
 
 #include <ki_exception.h>
 #include <sch_io/sch_io.h>
+#include <sch_io/sch_io_lib_cache.h>
 #include <sch_io/sch_io_mgr.h>
 #include <wx/translation.h>
 #include <wx/filename.h>
@@ -121,6 +122,18 @@ void SCH_IO::DeleteSymbol( const wxString& aLibraryPath, const wxString& aSymbol
 }
 
 
+std::unique_ptr<SCH_IO_LIB_CACHE> SCH_IO::ParseLibraryCache( const wxString& aLibraryPath ) const
+{
+    return nullptr;
+}
+
+
+void SCH_IO::AdoptLibraryCache( const wxString& aLibraryPath,
+                                std::unique_ptr<SCH_IO_LIB_CACHE> aCache )
+{
+}
+
+
 void SCH_IO::GetLibraryOptions( std::map<std::string, UTF8>* aListToAppendTo ) const
 {
     // Get base options first
@@ -27,11 +27,15 @@
 #include <sch_io/sch_io_mgr.h>
 #include <import_export.h>
 #include <map>
+#include <memory>
 #include <enum_vector.h>
 #include <reporter.h>
 #include <i18n_utility.h>
 #include <wx/arrstr.h>
 
+class SCH_IO_LIB_CACHE;
+
+
 /**
  * Base class that schematic file and library loading and saving plugins should derive from.
  * Implementations can provide either LoadSchematicFile() or SaveSchematicFile() functions,
@@ -256,6 +260,28 @@ public:
     virtual void DeleteSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                const std::map<std::string, UTF8>* aProperties = nullptr );
 
+    /**
+     * Read the library \a aLibraryPath into a new cache, without using the plugin's own cache.
+     *
+     * Unlike the other library functions, this can be called from a worker thread: it does
+     * not change the plugin, nor switch the locale.  The cache is then handed to the plugin
+     * of the library with AdoptLibraryCache(), from the main thread.
+     *
+     * @return the new cache, or nullptr if the plugin cannot read libraries this way.
+     * @throw IO_ERROR if the library cannot be read.
+     */
+    virtual std::unique_ptr<SCH_IO_LIB_CACHE>
+    ParseLibraryCache( const wxString& aLibraryPath ) const;
+
+    /**
+     * Use a cache returned by ParseLibraryCache() for the library \a aLibraryPath.
+     *
+     * The cache is discarded if the library is already loaded, so that the symbols handed out
+     * by the plugin stay valid.
+     */
+    virtual void AdoptLibraryCache( const wxString& aLibraryPath,
+                                    std::unique_ptr<SCH_IO_LIB_CACHE> aCache );
+
     /**
      * Append supported #SCH_IO options to \a aListToAppenTo along with internationalized
      * descriptions.  Options are typically appended so that a derived SCH_IO can call
@@ -0,0 +1,224 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <background_jobs_monitor.h>
+#include <core/thread_pool.h>
+#include <pgm_base.h>
+#include <sch_io/sch_io.h>
+#include <sch_io/sch_io_lib_cache.h>
+#include <symbol_lib_preloader.h>
+#include <symbol_lib_table.h>
+#include <trace_helpers.h>
+
+#include <wx/event.h>
+#include <wx/log.h>
+
+
+struct SYMBOL_LIB_PRELOADER::STATE
+{
+    struct LIBRARY
+    {
+        wxString                          m_nickname;
+        wxString                          m_uri;
+        SCH_IO_MGR::SCH_FILE_T            m_type;
+        std::unique_ptr<SCH_IO_LIB_CACHE> m_cache;      ///< Protected by m_mutex
+    };
+
+    SYMBOL_LIB_TABLE*               m_table = nullptr;  ///< Only used on the main thread
+    wxEvtHandler*                   m_handler = nullptr;
+    std::vector<LIBRARY>            m_libraries;
+    std::shared_ptr<BACKGROUND_JOB> m_job;
+
+    std::atomic<size_t>             m_nextLibrary{ 0 };
+    std::atomic<bool>               m_cancelled{ false };
+
+    std::mutex                      m_mutex;
+    std::condition_variable         m_finished;
+    size_t                          m_activeChains = 0;   ///< Protected by m_mutex
+};
+
+
+SYMBOL_LIB_PRELOADER::~SYMBOL_LIB_PRELOADER()
+{
+    Cancel();
+}
+
+
+void SYMBOL_LIB_PRELOADER::Start( SYMBOL_LIB_TABLE* aTable, wxEvtHandler* aHandler )
+{
+    Cancel();
+
+    if( !aTable || !aHandler )
+        return;
+
+    m_state = std::make_shared<STATE>();
+    m_state->m_table = aTable;
+    m_state->m_handler = aHandler;
+
+    // The worker threads only get copies of what they need from the table
+    for( const wxString& nickname : aTable->GetLogicalLibs() )
+    {
+        const SYMBOL_LIB_TABLE_ROW* row = aTable->FindRow( nickname, true );
+
+        if( row && !row->GetIsLoaded() )
+        {
+            m_state->m_libraries.push_back( { nickname, row->GetFullURI( true ),
+                                              row->SchLibType(), nullptr } );
+        }
+    }
+
+    if( m_state->m_libraries.empty() )
+        return;
+
+    m_state->m_job = Pgm().GetBackgroundJobMonitor().Create( _( "Loading Symbol Libraries" ) );
+    m_state->m_job->m_reporter->SetNumPhases( m_state->m_libraries.size() );
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    // Leave half of the pool to interactive work
+    size_t chains = std::max<size_t>( 1, tp.get_thread_count() / 2 );
+    chains = std::min( chains, m_state->m_libraries.size() );
+
+    m_state->m_activeChains = chains;
+
+    for( size_t ii = 0; ii < chains; ++ii )
+    {
+        std::shared_ptr<STATE> state = m_state;
+
+        tp.push_task(
+                [state]()
+                {
+                    loadNextLibrary( state );
+                } );
+    }
+}
+
+
+void SYMBOL_LIB_PRELOADER::Cancel()
+{
+    if( !m_state )
+        return;
+
+    m_state->m_cancelled = true;
+
+    std::unique_lock<std::mutex> lock( m_state->m_mutex );
+
+    m_state->m_finished.wait( lock,
+                              [&]()
+                              {
+                                  return m_state->m_activeChains == 0;
+                              } );
+
+    lock.unlock();
+    m_state.reset();
+}
+
+
+void SYMBOL_LIB_PRELOADER::loadNextLibrary( std::shared_ptr<STATE> aState )
+{
+    size_t libraryIndex = aState->m_nextLibrary++;
+
+    if( aState->m_cancelled || libraryIndex >= aState->m_libraries.size() )
+    {
+        std::lock_guard<std::mutex> lock( aState->m_mutex );
+
+        if( --aState->m_activeChains == 0 )
+        {
+            Pgm().GetBackgroundJobMonitor().Remove( aState->m_job );
+            aState->m_finished.notify_all();
+        }
+
+        return;
+    }
+
+    STATE::LIBRARY&          library = aState->m_libraries[libraryIndex];
+    BACKGROUND_JOB_REPORTER* reporter = aState->m_job->m_reporter.get();
+
+    reporter->Report( wxString::Format( _( "Loading library %s..." ), library.m_nickname ) );
+
+    try
+    {
+        // A plugin of our own, the ones of the library table are only used on the main thread
+        IO_RELEASER<SCH_IO> plugin( SCH_IO_MGR::FindPlugin( library.m_type ) );
+
+        // Plugins that cannot read a library without switching the locale return nothing;
+        // their libraries are loaded when first used.
+        std::unique_ptr<SCH_IO_LIB_CACHE> cache;
+
+        if( plugin )
+            cache = plugin->ParseLibraryCache( library.m_uri );
+
+        if( cache )
+        {
+            {
+                std::lock_guard<std::mutex> lock( aState->m_mutex );
+                library.m_cache = std::move( cache );
+            }
+
+            aState->m_handler->CallAfter(
+                    [aState, libraryIndex]()
+                    {
+                        adoptLibrary( aState, libraryIndex );
+                    } );
+        }
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        // Errors are reported when the library is used
+        wxLogTrace( traceSchPlugin, wxS( "Error preloading symbol library %s: %s" ),
+                    library.m_nickname, ioe.What() );
+    }
+    catch( const std::exception& e )
+    {
+        wxLogTrace( traceSchPlugin, wxS( "Error preloading symbol library %s: %s" ),
+                    library.m_nickname, e.what() );
+    }
+
+    reporter->AdvancePhase();
+
+    GetKiCadThreadPool().push_task(
+            [aState]()
+            {
+                loadNextLibrary( aState );
+            } );
+}
+
+
+void SYMBOL_LIB_PRELOADER::adoptLibrary( std::shared_ptr<STATE> aState, size_t aIndex )
+{
+    // The table may be gone once the preload is cancelled
+    if( aState->m_cancelled )
+        return;
+
+    STATE::LIBRARY&                   library = aState->m_libraries[aIndex];
+    std::unique_ptr<SCH_IO_LIB_CACHE> cache;
+
+    {
+        std::lock_guard<std::mutex> lock( aState->m_mutex );
+        cache = std::move( library.m_cache );
+    }
+
+    aState->m_table->AdoptSymbolLibCache( library.m_nickname, library.m_uri, library.m_type,
+                                          std::move( cache ) );
+}
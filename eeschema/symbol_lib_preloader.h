@@ -0,0 +1,80 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KICAD_SYMBOL_LIB_PRELOADER_H
+#define KICAD_SYMBOL_LIB_PRELOADER_H
+
+#include <memory>
+
+class SYMBOL_LIB_TABLE;
+class wxEvtHandler;
+
+
+/**
+ * Read the libraries of a symbol library table in the background so that they are already
+ * cached by their plugins when they are first used.
+ *
+ * The libraries are read by tasks on the KiCad thread pool into caches of their own, without
+ * touching the library table or its plugins, and progress is shown as a background job.  Each
+ * cache is then handed to the plugin of its library from the main thread, unless the library
+ * was loaded in the meantime.  Each task queues the next library when it is done rather than
+ * looping, so the preload never holds pool threads away from interactive work for more than
+ * one library.
+ */
+class SYMBOL_LIB_PRELOADER
+{
+public:
+    SYMBOL_LIB_PRELOADER() {}
+
+    ~SYMBOL_LIB_PRELOADER();
+
+    /**
+     * Start reading the libraries of \a aTable that are not loaded yet, cancelling any preload
+     * still running.
+     *
+     * @param aHandler is the event handler of the main thread used to hand the libraries
+     *                 over to \a aTable.
+     */
+    void Start( SYMBOL_LIB_TABLE* aTable, wxEvtHandler* aHandler );
+
+    /**
+     * Stop reading further libraries and wait for the ones being read to finish.
+     *
+     * Must be called before the library table is replaced or destroyed.
+     */
+    void Cancel();
+
+private:
+    struct STATE;
+
+    /**
+     * Read the next library of \a aState and queue another task for the one after it.
+     */
+    static void loadNextLibrary( std::shared_ptr<STATE> aState );
+
+    /**
+     * Hand the library \a aIndex of \a aState over to the library table.  Called on the main
+     * thread.
+     */
+    static void adoptLibrary( std::shared_ptr<STATE> aState, size_t aIndex );
+
+    std::shared_ptr<STATE> m_state;
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include <symbol_lib_table.h>
 #include <lib_symbol.h>
 #include <sch_io/database/sch_io_database.h>
+#include <sch_io/sch_io_lib_cache.h>
 #include <dialogs/dialog_database_lib_settings.h>
 
 #include <wx/dir.h>
@@ -413,6 +414,27 @@ void SYMBOL_LIB_TABLE::LoadSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 }
 
 
+void SYMBOL_LIB_TABLE::AdoptSymbolLibCache( const wxString& aNickname, const wxString& aURI,
+                                            SCH_IO_MGR::SCH_FILE_T aType,
+                                            std::unique_ptr<SCH_IO_LIB_CACHE> aCache )
+{
+    SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+
+    // The row may have been edited since the library was read
+    if( !row || !row->plugin || row->type != aType || row->GetFullURI( true ) != aURI )
+        return;
+
+    // Don't wait for a library being loaded by another thread; that load wins
+    std::unique_lock<std::mutex> lock( row->GetMutex(), std::try_to_lock );
+
+    if( !lock.owns_lock() )
+        return;
+
+    row->plugin->AdoptLibraryCache( aURI, std::move( aCache ) );
+    row->SetLoaded( true );
+}
+
+
 LIB_SYMBOL* SYMBOL_LIB_TABLE::LoadSymbol( const wxString& aNickname, const wxString& aSymbolName )
 {
     SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
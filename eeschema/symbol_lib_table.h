@@ -196,6 +196,17 @@ public:
     void LoadSymbolLib( std::vector<LIB_SYMBOL*>& aAliasList, const wxString& aNickname,
                         bool aPowerSymbolsOnly = false );
 
+    /**
+     * Hand a cache read by SCH_IO::ParseLibraryCache() over to the plugin of the library given
+     * by @a aNickname.
+     *
+     * Nothing is done if the library is no longer the file @a aURI of type @a aType, or if it
+     * is being loaded by another thread.  Must be called from the main thread.
+     */
+    void AdoptSymbolLibCache( const wxString& aNickname, const wxString& aURI,
+                              SCH_IO_MGR::SCH_FILE_T aType,
+                              std::unique_ptr<SCH_IO_LIB_CACHE> aCache );
+
     /**
      * Load a #LIB_SYMBOL having @a aName from the library given by @a aNickname.
      *
@@ -247,7 +247,14 @@ bool SCH_EDITOR_CONTROL::RescueSymbolLibTableProject( bool aRunningOnDemand )
 
 bool SCH_EDITOR_CONTROL::rescueProject( RESCUER& aRescuer, bool aRunningOnDemand )
 {
-    if( !RESCUER::RescueProject( m_frame, aRescuer, aRunningOnDemand ) )
+    // The rescue replaces the project symbol library table
+    m_frame->CancelLibraryPreload();
+
+    bool rescued = RESCUER::RescueProject( m_frame, aRescuer, aRunningOnDemand );
+
+    m_frame->StartLibraryPreload();
+
+    if( !rescued )
         return false;
 
     if( aRescuer.GetCandidateCount() )
@@ -279,7 +286,9 @@ int SCH_EDITOR_CONTROL::RemapSymbols( const TOOL_EVENT& aEvent )
 {
     DIALOG_SYMBOL_REMAP dlgRemap( m_frame );
 
+    m_frame->CancelLibraryPreload();
     dlgRemap.ShowQuasiModal();
+    m_frame->StartLibraryPreload();
 
     m_frame->GetCanvas()->Refresh( true );
 
@@ -94,7 +94,8 @@ void AM_PRIMITIVE::ConvertBasicShapeToPolygon( APERTURE_MACRO* aApertMacro,
     // Draw the primitive shape for flashed items.
     // Note: rotation of primitives inside a macro must be always done around the macro origin.
     // Create a static buffer to avoid a lot of memory reallocation.
-    static std::vector<VECTOR2I> polybuffer;
+    // It is thread_local because macros of several images can be converted at the same time.
+    static thread_local std::vector<VECTOR2I> polybuffer;
     polybuffer.clear();
 
     aApertMacro->EvalLocalParams( *this );
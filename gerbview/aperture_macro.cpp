@@ -86,6 +86,7 @@ void APERTURE_MACRO::AddPrimitiveToList( AM_PRIMITIVE& aPrimitive )
 {
     m_primitivesList.push_back( aPrimitive );
     m_primitivesList.back().m_LocalParamLevel = m_localParamStack.size();
+    m_shapeCache.clear();
 }
 
 void APERTURE_MACRO::AddLocalParamDefToStack()
@@ -100,14 +101,22 @@ AM_PARAM& APERTURE_MACRO::GetLastLocalParamDefFromStack()
 }
 
 
-SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
-                                                       const VECTOR2I& aShapePos )
+const SHAPE_POLY_SET& APERTURE_MACRO::getShape( const D_CODE* aDcode )
 {
-    SHAPE_POLY_SET holeBuffer;
+    std::vector<double> key;
+
+    for( unsigned id_param = 1; id_param <= aDcode->GetParamCount(); id_param++ )
+        key.push_back( aDcode->GetParam( id_param ) );
+
+    auto it = m_shapeCache.find( key );
+
+    if( it != m_shapeCache.end() )
+        return it->second;
+
+    SHAPE_POLY_SET& shape = m_shapeCache[key];
+    SHAPE_POLY_SET  holeBuffer;
 
-    m_shape.RemoveAllContours();
-    D_CODE* dcode = aParent->GetDcodeDescr();
-    InitLocalParams( dcode );
+    InitLocalParams( aDcode );
 
     for( AM_PRIMITIVE& prim_macro : m_primitivesList )
     {
@@ -116,7 +125,7 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
 
         if( prim_macro.IsAMPrimitiveExposureOn( this ) )
         {
-            prim_macro.ConvertBasicShapeToPolygon( this, m_shape );
+            prim_macro.ConvertBasicShapeToPolygon( this, shape );
         }
         else
         {
@@ -124,19 +133,28 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                m_shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
                 holeBuffer.RemoveAllContours();
             }
         }
     }
 
     // Merge and cleanup basic shape polygons
-    m_shape.Simplify( SHAPE_POLY_SET::PM_FAST );
+    shape.Simplify( SHAPE_POLY_SET::PM_FAST );
 
     // A hole can be is defined inside a polygon, or the polygons themselve can create
     // a hole when merged, so we must fracture the polygon to be able to drawn it
     // (i.e link holes by overlapping edges)
-    m_shape.Fracture( SHAPE_POLY_SET::PM_FAST );
+    shape.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    return shape;
+}
+
+
+SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
+                                                       const VECTOR2I& aShapePos )
+{
+    m_shape = getShape( aParent->GetDcodeDescr() );
 
     // Move m_shape to the actual draw position:
     for( int icnt = 0; icnt < m_shape.OutlineCount(); icnt++ )
@@ -31,6 +31,7 @@
 #define APERTURE_MACRO_H
 
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -112,6 +113,8 @@ public:
      * Calculate the primitive shape for flashed items.
      *
      * When an item is flashed, this is the shape of the item.
+     * The shape itself is built only once for each set of D_CODE parameters, flashes only
+     * have to move the cached shape to their position.
      *
      * @return the shape of the item.
      * @param aParent is the parent #GERBER_DRAW_ITEM which is actually drawn.
@@ -141,6 +144,12 @@ public:
     AM_PARAM& GetLastLocalParamDefFromStack();
 
 private:
+    /**
+     * @return the shape of the aperture macro instanced by \a aDcode, at (0,0) and before
+     *         any item or layer transform.  Built on first use, then served from m_shapeCache.
+     */
+    const SHAPE_POLY_SET& getShape( const D_CODE* aDcode );
+
     /**
      * A list of AM_PRIMITIVEs to define the shape of the aperture macro
      */
@@ -166,6 +175,12 @@ private:
     int m_paramLevelEval;
 
     SHAPE_POLY_SET m_shape;         ///< The shape of the item, calculated by GetApertureMacroShape
+
+    /**
+     * The untransformed shapes already built by getShape().  The key is the list of D_CODE
+     * parameters, so all the D_CODEs instancing this macro with the same values share a shape.
+     */
+    std::map<std::vector<double>, SHAPE_POLY_SET> m_shapeCache;
 };
 
 
@@ -285,19 +285,7 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
         return false;
     }
 
-    // Display errors list
-    if( drill_layer->GetMessages().size() > 0 )
-    {
-        HTML_MESSAGE_BOX dlg( this, _( "Error reading EXCELLON drill file" ) );
-        dlg.ListSet( drill_layer->GetMessages() );
-        dlg.ShowModal();
-    }
-
-    if( GetCanvas() )
-    {
-        for( GERBER_DRAW_ITEM* item : drill_layer->GetItems() )
-            GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
-    }
+    finishImageLoad( drill_layer );
 
     return success;
 }
@@ -551,7 +539,7 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName, EXCELLON_DEFAULTS
     X2_ATTRIBUTE dummy;
     char* text = (char*)file_attribute;
     int dummyline = 0;
-    dummy.ParseAttribCmd( nullptr, nullptr, 0, text, dummyline );
+    dummy.ParseAttribCmd( nullptr, text, dummyline );
     delete m_FileFunction;
     m_FileFunction = new X2_ATTRIBUTE_FILEFUNCTION( dummy );
 
@@ -26,14 +26,19 @@
 #include <wx/filedlg.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
+#include <wx/msgdlg.h>
 #include <reporter.h>
 #include <dialogs/html_message_box.h>
 #include <gerbview_frame.h>
+#include <gerbview_draw_panel_gal.h>
 #include <gerbview_id.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
 #include <excellon_image.h>
+#include <excellon_defaults.h>
+#include <gerbview_settings.h>
 #include <lset.h>
+#include <macros.h>
 #include <wildcards_and_files_ext.h>
 #include <view/view.h>
 #include <widgets/wx_progress_reporters.h>
@@ -250,19 +255,20 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
     wxCHECK_MSG( aFilenameList.Count() == aFileType->size(), false,
                  "Mismatch in file names and file types count" );
 
+    using LOAD_REQUEST = GERBER_FILE_IMAGE_LIST::LOAD_REQUEST;
+
     wxFileName filename;
 
     // Read gerber files: each file is loaded on a new GerbView layer
     bool success = true;
-    int layer = GetActiveLayer();
     int  firstLoadedLayer = NO_AVAILABLE_LAYERS;
     LSET visibility = GetVisibleLayers();
 
     // Manage errors when loading files
     WX_STRING_REPORTER reporter;
 
-    // Create progress dialog (only used if more than 1 file to load
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    std::vector<LOAD_REQUEST> requests;
+    unsigned availableLayers = ImagesMaxCount() - GetImagesList()->GetLoadedImageCount();
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -295,33 +301,10 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             continue;
         }
 
-
         m_lastFileName = filename.GetFullPath();
 
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
-        {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Loading files..." ), 1,
-                                                               false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-        }
-        else if( progress )
-        {
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-            progress->KeepRefreshing();
-        }
-
-
         // Make sure we have a layer available to load into
-        layer = getNextAvailableLayer();
-
-        if( layer == NO_AVAILABLE_LAYERS )
+        if( requests.size() >= availableLayers )
         {
             success = false;
             reporter.Report( MSG_NO_MORE_LAYER, RPT_SEVERITY_ERROR );
@@ -336,65 +319,97 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             break;
         }
 
-        SetActiveLayer( layer, false );
-        visibility[ layer ] = true;
+        // 2 = Autodetect
+        if( ( *aFileType )[ii] == 2 )
+        {
+            if( EXCELLON_IMAGE::TestFileIsExcellon( filename.GetFullPath() ) )
+                ( *aFileType )[ii] = 1;
+            else if( GERBER_FILE_IMAGE::TestFileIsRS274( filename.GetFullPath() ) )
+                ( *aFileType )[ii] = 0;
+        }
 
-        try
+        if( ( *aFileType )[ii] != 0 && ( *aFileType )[ii] != 1 )
         {
-            // 2 = Autodetect
-            if( ( *aFileType )[ii] == 2 )
-            {
-                if( EXCELLON_IMAGE::TestFileIsExcellon( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 1;
-                else if( GERBER_FILE_IMAGE::TestFileIsRS274( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 0;
-            }
+            wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
+            reporter.Report( txt, RPT_SEVERITY_ERROR );
+            continue;
+        }
 
-            switch( ( *aFileType )[ii] )
-            {
-            case 0:
+        LOAD_REQUEST request;
+        request.m_FileName = filename.GetFullPath();
+        request.m_IsDrill = ( *aFileType )[ii] == 1;
+        requests.push_back( request );
+    }
 
-                if( Read_GERBER_File( filename.GetFullPath() ) )
-                {
-                    UpdateFileHistory( filename.GetFullPath() );
+    // Create progress dialog (only used if more than 1 file to load
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
 
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
-                    {
-                        firstLoadedLayer = layer;
-                    }
-                }
+    if( requests.size() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Loading files..." ), 1,
+                                                           false );
+        progress->SetMaxProgress( requests.size() );
+        progress->Report( wxString::Format( _( "Loading %zu files..." ), requests.size() ) );
+    }
 
-                break;
+    // All files are parsed concurrently; the images are added to the list in the order of the
+    // file list, so the layer order is the same as when loading them one by one.
+    EXCELLON_DEFAULTS nc_defaults;
+    static_cast<GERBVIEW_SETTINGS*>( config() )->GetExcellonDefaults( nc_defaults );
 
-            case 1:
+    GetImagesList()->LoadFiles( requests, nc_defaults, progress.get() );
 
-                if( Read_EXCELLON_File( filename.GetFullPath() ) )
-                {
-                    UpdateFileHistory( filename.GetFullPath(), &m_drillFileHistory );
+    progress.reset();
 
-                    // Select the first added layer by default when done loading
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
-                    {
-                        firstLoadedLayer = layer;
-                    }
-                }
+    // Prepare the draw geometry of the new layers concurrently, before their items are added
+    // to the view
+    std::vector<int> loadedLayers;
 
-                break;
-            default:
-                wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                reporter.Report( txt, RPT_SEVERITY_ERROR );
-            }
-        }
-        catch( const std::bad_alloc& )
+    for( const LOAD_REQUEST& request : requests )
+    {
+        if( request.m_Status == LOAD_REQUEST::STATUS::LOADED )
+            loadedLayers.push_back( request.m_Layer );
+    }
+
+    static_cast<GERBVIEW_DRAW_PANEL_GAL*>( GetCanvas() )->CacheLayerGeometry( loadedLayers );
+
+    for( const LOAD_REQUEST& request : requests )
+    {
+        filename = request.m_FileName;
+
+        switch( request.m_Status )
         {
-            wxString txt = wxString::Format( MSG_OOM, filename.GetFullName() );
-            reporter.Report( txt, RPT_SEVERITY_ERROR );
+        case LOAD_REQUEST::STATUS::LOADED:
+            visibility[ request.m_Layer ] = true;
+
+            if( request.m_IsDrill )
+                UpdateFileHistory( request.m_FileName, &m_drillFileHistory );
+            else
+                UpdateFileHistory( request.m_FileName );
+
+            // Select the first added layer by default when done loading
+            if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
+                firstLoadedLayer = request.m_Layer;
+
+            finishImageLoad( GetGbrImage( request.m_Layer ) );
+            break;
+
+        case LOAD_REQUEST::STATUS::OUT_OF_MEMORY:
+            reporter.Report( wxString::Format( MSG_OOM, filename.GetFullName() ),
+                             RPT_SEVERITY_ERROR );
             success = false;
-            continue;
-        }
+            break;
 
-        if( progress )
-            progress->AdvanceProgress();
+        case LOAD_REQUEST::STATUS::NO_ROOM:
+            reporter.Report( MSG_NO_MORE_LAYER, RPT_SEVERITY_ERROR );
+            KI_FALLTHROUGH;
+
+        case LOAD_REQUEST::STATUS::NOT_LOADED:
+            reporter.Report( wxString::Format( MSG_NOT_LOADED, filename.GetFullName() ),
+                             RPT_SEVERITY_ERROR );
+            success = false;
+            break;
+        }
     }
 
     if( !success )
@@ -425,6 +440,52 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
 
 
 
+void GERBVIEW_FRAME::finishImageLoad( GERBER_FILE_IMAGE* aImage )
+{
+    bool isDrill = dynamic_cast<EXCELLON_IMAGE*>( aImage ) != nullptr;
+
+    // Display errors list
+    if( aImage->GetMessages().size() > 0 )
+    {
+        HTML_MESSAGE_BOX dlg( this, isDrill ? _( "Error reading EXCELLON drill file" )
+                                            : _( "Errors" ) );
+        dlg.ListSet( aImage->GetMessages() );
+        dlg.ShowModal();
+    }
+
+    /* if the gerber file has items using D codes but missing D codes definitions,
+     * it can be a deprecated RS274D file (i.e. without any aperture information),
+     * or has missing definitions,
+     * warn the user:
+     */
+    if( !isDrill && aImage->GetItemsCount() && aImage->m_Has_MissingDCode )
+    {
+        wxString msg;
+
+        if( !aImage->m_Has_DCode )
+            msg = _("Warning: this file has no D-Code definition\n"
+                    "Therefore the size of some items is undefined");
+        else
+            msg = _("Warning: this file has some missing D-Code definitions\n"
+                    "Therefore the size of some items is undefined");
+
+        wxMessageBox( msg );
+    }
+
+    if( GetCanvas() )
+    {
+        if( aImage->m_ImageNegative )
+        {
+            // TODO: find a way to handle negative images
+            // (maybe convert geometry into positives?)
+        }
+
+        for( GERBER_DRAW_ITEM* item : aImage->GetItems() )
+            GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
+    }
+}
+
+
 bool GERBVIEW_FRAME::unarchiveFiles( const wxString& aFullFileName, REPORTER* aReporter )
 {
     bool     foundX2Gerbers = false;
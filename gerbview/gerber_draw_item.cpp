@@ -63,18 +63,11 @@ GERBER_DRAW_ITEM::~GERBER_DRAW_ITEM()
 }
 
 
-void GERBER_DRAW_ITEM::SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes )
+const GBR_NETLIST_METADATA& GERBER_DRAW_ITEM::GetNetAttributes() const
 {
-    m_netAttributes = aNetAttributes;
+    static const GBR_NETLIST_METADATA noNetAttributes;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP )
-        || ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
-    {
-        m_GerberImageFile->m_ComponentsList.insert( std::make_pair( m_netAttributes.m_Cmpref, 0 ) );
-    }
-
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
-        m_GerberImageFile->m_NetnamesList.insert( std::make_pair( m_netAttributes.m_Netname, 0 ) );
+    return m_netAttributes ? *m_netAttributes : noNetAttributes;
 }
 
 
@@ -639,6 +632,67 @@ void GERBER_DRAW_ITEM::ConvertSegmentToPolygon()
 }
 
 
+void GERBER_DRAW_ITEM::CacheDrawGeometry( bool aTriangulate )
+{
+    D_CODE* code = GetDcodeDescr();
+
+    switch( m_ShapeType )
+    {
+    case GBR_POLYGON:
+        if( m_AbsolutePolygon.OutlineCount() == 0 )
+        {
+            std::vector<VECTOR2I> pts = m_ShapeAsPolygon.COutline( 0 ).CPoints();
+
+            for( VECTOR2I& pt : pts )
+                pt = GetABPosition( pt );
+
+            SHAPE_LINE_CHAIN chain( pts );
+            chain.SetClosed( true );
+            m_AbsolutePolygon.AddOutline( chain );
+        }
+
+        // Degenerated polygons (having < 3 points) are drawn as lines
+        if( aTriangulate && m_AbsolutePolygon.COutline( 0 ).PointCount() >= 3
+                && !m_AbsolutePolygon.IsTriangulationUpToDate() )
+        {
+            // Use the fastest calculation mode: no partition created because the partition
+            // is useless in Gerbview, and very time consuming
+            m_AbsolutePolygon.CacheTriangulation( false );
+        }
+
+        break;
+
+    case GBR_SEGMENT:
+        if( code && code->m_ApertType == APT_RECT && m_ShapeAsPolygon.OutlineCount() == 0 )
+            ConvertSegmentToPolygon();
+
+        break;
+
+    case GBR_SPOT_MACRO:
+        if( m_AbsolutePolygon.OutlineCount() == 0 && code && code->GetMacro() )
+            m_AbsolutePolygon = *code->GetMacro()->GetApertureMacroShape( this, m_Start );
+
+        break;
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+        // Only polygons and shapes with a hole are drawn from the D_CODE polygon
+        if( code && code->m_Polygon.OutlineCount() == 0
+                && ( m_ShapeType == GBR_SPOT_POLY || code->m_DrillShape != APT_DEF_NO_HOLE ) )
+        {
+            code->ConvertShapeToPolygon( this );
+        }
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+
 void GERBER_DRAW_ITEM::PrintGerberPoly( wxDC* aDC, const COLOR4D& aColor, const VECTOR2I& aOffset,
                                         bool aFilledShape )
 {
@@ -735,45 +789,47 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_
     aList.emplace_back( _( "AB axis" ), msg );
 
     // Display net info, if exists
-    if( m_netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
+    const GBR_NETLIST_METADATA& netAttributes = GetNetAttributes();
+
+    if( netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
         return;
 
     // Build full net info:
     wxString net_msg;
     wxString cmp_pad_msg;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
     {
         net_msg = _( "Net:" );
         net_msg << wxS( " " );
 
-        if( m_netAttributes.m_Netname.IsEmpty() )
+        if( netAttributes.m_Netname.IsEmpty() )
             net_msg << _( "<no net>" );
         else
-            net_msg << UnescapeString( m_netAttributes.m_Netname );
+            net_msg << UnescapeString( netAttributes.m_Netname );
     }
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
     {
-        if( m_netAttributes.m_PadPinFunction.IsEmpty() )
+        if( netAttributes.m_PadPinFunction.IsEmpty() )
         {
             cmp_pad_msg.Printf( _( "Cmp: %s  Pad: %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname.GetValue() );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname.GetValue() );
         }
         else
         {
             cmp_pad_msg.Printf( _( "Cmp: %s  Pad: %s  Fct %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname.GetValue(),
-                                m_netAttributes.m_PadPinFunction.GetValue() );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname.GetValue(),
+                                netAttributes.m_PadPinFunction.GetValue() );
         }
     }
 
-    else if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
+    else if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
     {
         cmp_pad_msg = _( "Cmp:" );
-        cmp_pad_msg << wxS( " " ) << m_netAttributes.m_Cmpref;
+        cmp_pad_msg << wxS( " " ) << netAttributes.m_Cmpref;
     }
 
     aList.emplace_back( net_msg, cmp_pad_msg );
@@ -33,6 +33,8 @@
 #include <geometry/shape_poly_set.h>
 #include <geometry/eda_angle.h>
 
+#include <memory>
+
 class GERBER_FILE_IMAGE;
 class GBR_LAYOUT;
 class D_CODE;
@@ -66,8 +68,18 @@ public:
     GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberparams );
     ~GERBER_DRAW_ITEM();
 
-    void SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
-    const GBR_NETLIST_METADATA& GetNetAttributes() const { return m_netAttributes; }
+    /**
+     * Set the net attributes of this item.
+     *
+     * The attributes are shared by all the items created with the same %TO attributes, see
+     * GERBER_FILE_IMAGE::GetSharedNetAttributes().
+     */
+    void SetNetAttributes( const std::shared_ptr<const GBR_NETLIST_METADATA>& aNetAttributes )
+    {
+        m_netAttributes = aNetAttributes;
+    }
+
+    const GBR_NETLIST_METADATA& GetNetAttributes() const;
 
     /**
      * Return the layer this item is on.
@@ -165,6 +177,19 @@ public:
     void ConvertSegmentToPolygon();
     void ConvertSegmentToPolygon( SHAPE_POLY_SET* aPolygon ) const;
 
+    /**
+     * Build the geometry the painter needs to draw this item, if not already done: the
+     * absolute polygon of regions and aperture macros, the polygon of segments drawn with a
+     * rectangular pen and the polygon of the D_CODE.
+     *
+     * This allows the draw geometry to be built outside of the painter, on a worker thread.
+     * Items sharing a D_CODE (i.e. items of the same image) must not be handled concurrently.
+     *
+     * @param aTriangulate is true to also triangulate the absolute polygon of regions, as
+     *                     required to draw them filled on OpenGL.
+     */
+    void CacheDrawGeometry( bool aTriangulate );
+
     /**
      * Print the polygon stored in m_PolyCorners.
      */
@@ -270,9 +295,10 @@ private:
     VECTOR2I    m_drawScale;                // A and B scaling factor
     VECTOR2I    m_layerOffset;              // Offset for A and B axis, from OF parameter
     double      m_lyrRotation;              // Fine rotation, from OR parameter, in degrees
-    GBR_NETLIST_METADATA m_netAttributes;   ///< the string given by a %TO attribute set in aperture
-                                            ///< (dcode). Stored in each item, because %TO is
-                                            ///< a dynamic object attribute
+    std::shared_ptr<const GBR_NETLIST_METADATA> m_netAttributes;
+                                            ///< the string given by a %TO attribute set in
+                                            ///< aperture (dcode). Referenced by each item,
+                                            ///< because %TO is a dynamic object attribute
 };
 
 
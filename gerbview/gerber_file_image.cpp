@@ -228,6 +228,7 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
     m_Selected_Tool = 0;
     m_Last_Pen_Command = 0;
     m_Exposure = false;
+    m_sharedNetAttributes.reset();
 
     m_DisplayOffset.x = m_DisplayOffset.y = 0;
     m_DisplayRotation = ANGLE_0;
@@ -383,12 +384,35 @@ void GERBER_FILE_IMAGE::RemoveAttribute( X2_ATTRIBUTE& aAttribute )
      */
     wxString cmd = aAttribute.GetPrm( 0 );
     m_NetAttributeDict.ClearAttribute( &cmd );
+    m_sharedNetAttributes.reset();
 
     if( cmd.IsEmpty() || cmd == wxT( ".AperFunction" ) )
         m_AperFunction.Clear();
 }
 
 
+const std::shared_ptr<const GBR_NETLIST_METADATA>& GERBER_FILE_IMAGE::GetSharedNetAttributes()
+{
+    if( !m_sharedNetAttributes )
+    {
+        m_sharedNetAttributes = std::make_shared<const GBR_NETLIST_METADATA>( m_NetAttributeDict );
+
+        const GBR_NETLIST_METADATA& attr = *m_sharedNetAttributes;
+
+        if( ( attr.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP )
+            || ( attr.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+        {
+            m_ComponentsList.insert( std::make_pair( attr.m_Cmpref, 0 ) );
+        }
+
+        if( ( attr.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+            m_NetnamesList.insert( std::make_pair( attr.m_Netname, 0 ) );
+    }
+
+    return m_sharedNetAttributes;
+}
+
+
 INSPECT_RESULT GERBER_FILE_IMAGE::Visit( INSPECTOR inspector, void* testData,
                                          const std::vector<KICAD_T>& aScanTypes )
 {
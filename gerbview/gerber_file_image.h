@@ -25,6 +25,7 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <memory>
 #include <vector>
 #include <set>
 
@@ -33,6 +34,7 @@
 #include <am_primitive.h>
 #include <aperture_macro.h>
 #include <gbr_netlist_metadata.h>
+#include <gerber_file_reader.h>
 
 typedef std::vector<GERBER_DRAW_ITEM*> GERBER_DRAW_ITEMS;
 
@@ -99,10 +101,6 @@ public:
                                         // and the actual coordinates calculation must handle this
 };
 
-// size of a single line of text from a gerber file.
-// warning: some files can have *very long* lines, so the buffer must be large.
-#define GERBER_BUFZ 1000000
-
 /**
  * Hold the image data and parameters for one gerber file and layer parameters.
  *
@@ -306,6 +304,14 @@ public:
      */
     void RemoveAttribute( X2_ATTRIBUTE& aAttribute );
 
+    /**
+     * Return the current net attributes (m_NetAttributeDict) for a new item.
+     *
+     * Flashes and draws usually come in long runs using the same %TO attributes, so all the
+     * items created until the attributes are changed share the same copy.
+     */
+    const std::shared_ptr<const GBR_NETLIST_METADATA>& GetSharedNetAttributes();
+
     ///< @copydoc EDA_ITEM::Visit()
     INSPECT_RESULT Visit( INSPECTOR inspector, void* testData,
                           const std::vector<KICAD_T>& aScanTypes ) override;
@@ -320,28 +326,24 @@ private:
     /**
      * Test for an end of line.
      *
-     * If a end of line is found, read a new line.
+     * If a end of line is found, read a new line from m_reader.
      *
-     * @param aBuff = buffer (size = GERBER_BUFZ) to fill with a new line
-     * @param aText = pointer to the last useful char in aBuff
-     *          on return: points the beginning of the next line.
-     * @param aBuffSize = the size in bytes of aBuff
-     * @param aFile = the opened GERBER file to read
+     * @param aText = pointer to the last useful char in the current line
      * @return a pointer to the beginning of the next line or NULL if end of file
     */
-    char* GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile );
+    char* GetNextLine( char* aText );
 
-    bool GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* aGerberFile );
+    bool GetEndOfBlock( char*& aText );
 
     /**
      * Read a single RS274X command terminated with a %
      */
-    bool ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText );
+    bool ReadRS274XCommand( char*& aText );
 
     /**
      * Execute a RS274X command
      */
-    bool ExecuteRS274XCommand( int aCommand, char* aBuff, unsigned int aBuffSize, char*& aText );
+    bool ExecuteRS274XCommand( int aCommand, char*& aText );
 
     /**
      * Read two bytes of data and assembles them into an int with the first
@@ -357,15 +359,11 @@ private:
     /**
      * Read in an aperture macro and saves it in m_aperture_macros.
      *
-     * @param aBuff a character buffer at least GERBER_BUFZ long that can be
-     *              used to read successive lines from the gerber file.
      * @param text A reference to a character pointer which gives the initial
-     *             text to read from.
-     * @param aBuffSize is the size of aBuff
-     * @param gerber_file Which file to read from for continuation.
+     *             text to read from.  Continuation lines are read from m_reader.
      * @return true if a macro was read in successfully, else false.
      */
-    bool ReadApertureMacro( char *aBuff, unsigned int aBuffSize, char*& text, FILE* gerber_file );
+    bool ReadApertureMacro( char*& text );
 
     // functions to execute G commands or D basic commands:
     bool Execute_G_Command( char*& text, int G_command );
@@ -473,8 +471,9 @@ public:
     VECTOR2I           m_DisplayOffset;
     EDA_ANGLE          m_DisplayRotation;
 
-    // A large buffer to store one line
-    static char m_LineBuffer[GERBER_BUFZ+1];
+    // The gerber file being read.  Each image owns its reader so several files can be
+    // parsed at the same time.
+    GERBER_FILE_READER m_reader;
 
 private:
     wxArrayString      m_messagesList;         // A list of messages created when reading a file
@@ -490,6 +489,9 @@ private:
      *  - 1 have negative items found.
      */
     int                m_hasNegativeItems;
+
+    ///< The copy of m_NetAttributeDict shared by the new items, null when it must be rebuilt
+    std::shared_ptr<const GBR_NETLIST_METADATA> m_sharedNetAttributes;
 };
 
 #endif  // ifndef GERBER_FILE_IMAGE_H
@@ -31,10 +31,16 @@
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <excellon_image.h>
+#include <excellon_defaults.h>
 #include <X2_gerber_attributes.h>
+#include <locale_io.h>
+#include <progress_reporter.h>
+#include <core/thread_pool.h>
 #include <wx/filename.h>
 
 #include <map>
+#include <memory>
 
 
 // The global image list:
@@ -124,6 +130,119 @@ void GERBER_FILE_IMAGE_LIST::DeleteImage( unsigned int aIdx )
 }
 
 
+void GERBER_FILE_IMAGE_LIST::LoadFiles( std::vector<LOAD_REQUEST>& aRequests,
+                                        const EXCELLON_DEFAULTS& aDrillDefaults,
+                                        PROGRESS_REPORTER* aReporter )
+{
+    using STATUS = LOAD_REQUEST::STATUS;
+
+    thread_pool&                                                 tp = GetKiCadThreadPool();
+    std::vector<std::future<std::unique_ptr<GERBER_FILE_IMAGE>>> returns;
+
+    // The parsers switch to the C locale, which is process wide: switch once for all of them
+    // here, so the workers do not toggle it while other files are being read.
+    LOCALE_IO toggleIo;
+
+    auto loadFile =
+            [&aDrillDefaults, aReporter]( LOAD_REQUEST* aRequest )
+                    -> std::unique_ptr<GERBER_FILE_IMAGE>
+            {
+                std::unique_ptr<GERBER_FILE_IMAGE> image;
+
+                try
+                {
+                    // The layer is set when the image is added to the list
+                    if( aRequest->m_IsDrill )
+                    {
+                        auto              drill = std::make_unique<EXCELLON_IMAGE>( 0 );
+                        EXCELLON_DEFAULTS defaults = aDrillDefaults;
+
+                        if( drill->LoadFile( aRequest->m_FileName, &defaults ) )
+                            image = std::move( drill );
+                    }
+                    else
+                    {
+                        image = std::make_unique<GERBER_FILE_IMAGE>( 0 );
+
+                        if( !image->LoadGerberFile( aRequest->m_FileName ) )
+                            image.reset();
+                    }
+                }
+                catch( const std::bad_alloc& )
+                {
+                    image.reset();
+                    aRequest->m_Status = STATUS::OUT_OF_MEMORY;
+                }
+
+                if( aReporter )
+                    aReporter->AdvanceProgress();
+
+                return image;
+            };
+
+    for( LOAD_REQUEST& request : aRequests )
+    {
+        request.m_Status = STATUS::NOT_LOADED;
+        request.m_Layer = -1;
+        returns.push_back( tp.submit( loadFile, &request ) );
+    }
+
+    for( size_t ii = 0; ii < returns.size(); ++ii )
+    {
+        std::future_status status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+
+        while( status != std::future_status::ready )
+        {
+            if( aReporter )
+                aReporter->KeepRefreshing();
+
+            status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+        }
+
+        std::unique_ptr<GERBER_FILE_IMAGE> image = returns[ii].get();
+
+        if( !image )
+            continue;
+
+        int layer = AddGbrImage( image.get(), -1 );
+
+        if( layer < 0 )
+        {
+            aRequests[ii].m_Status = STATUS::NO_ROOM;
+            continue;
+        }
+
+        image.release()->m_GraphicLayer = layer;
+        aRequests[ii].m_Status = STATUS::LOADED;
+        aRequests[ii].m_Layer = layer;
+    }
+}
+
+
+void GERBER_FILE_IMAGE_LIST::CacheDrawGeometry( const std::vector<int>& aLayers,
+                                                bool aTriangulate )
+{
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<void>> returns;
+
+    auto cacheImage =
+            [aTriangulate]( GERBER_FILE_IMAGE* aImage )
+            {
+                for( GERBER_DRAW_ITEM* item : aImage->GetItems() )
+                    item->CacheDrawGeometry( aTriangulate );
+            };
+
+    for( int layer : aLayers )
+    {
+        if( GERBER_FILE_IMAGE* image = GetGbrImage( layer ) )
+            returns.push_back( tp.submit( cacheImage, image ) );
+    }
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
+}
+
+
 const wxString GERBER_FILE_IMAGE_LIST::GetDisplayName( int aIdx, bool aNameOnly, bool aFullName )
 {
     wxString name;
@@ -77,6 +77,8 @@ typedef bool( LayerSortFunction )( const GERBER_FILE_IMAGE* const& ref,
                                    const GERBER_FILE_IMAGE* const& test );
 
 class GERBER_FILE_IMAGE;
+class PROGRESS_REPORTER;
+struct EXCELLON_DEFAULTS;
 
 /**
  * @brief GERBER_FILE_IMAGE_LIST is a helper class to handle a list of GERBER_FILE_IMAGE files
@@ -192,6 +194,52 @@ public:
      */
     unsigned GetLoadedImageCount();
 
+    /**
+     * A gerber or drill file to read with LoadFiles(), and the result of the read.
+     */
+    struct LOAD_REQUEST
+    {
+        enum class STATUS
+        {
+            NOT_LOADED,     ///< the file could not be read
+            LOADED,
+            OUT_OF_MEMORY,
+            NO_ROOM         ///< the file was read but all layers are in use
+        };
+
+        wxString m_FileName;
+        bool     m_IsDrill = false;     ///< true for an Excellon drill file
+
+        STATUS   m_Status = STATUS::NOT_LOADED;
+        int      m_Layer = -1;          ///< the layer used by the image, if loaded
+    };
+
+    /**
+     * Read a set of gerber and drill files concurrently.
+     *
+     * Each file is parsed in its own image on the thread pool.  The images are then added to
+     * the first free layers in the order of \a aRequests, so the resulting layer order does not
+     * depend on which file finished first.
+     *
+     * @param aRequests is the list of files to read.  The status and layer are updated.
+     * @param aDrillDefaults are the default values used for Excellon files.
+     * @param aReporter is an optional progress reporter, advanced once per file.
+     */
+    void LoadFiles( std::vector<LOAD_REQUEST>& aRequests, const EXCELLON_DEFAULTS& aDrillDefaults,
+                    PROGRESS_REPORTER* aReporter = nullptr );
+
+    /**
+     * Build the draw geometry of the items of a set of graphic layers ahead of painting.
+     *
+     * The layers are handled concurrently on the thread pool, one task per layer, because the
+     * items of an image share its D_CODEs and aperture macros.
+     *
+     * @param aLayers is the list of graphic layers (0 .. GERBER_DRAWLAYERS_COUNT-1) to prepare.
+     * @param aTriangulate is true to also triangulate the filled polygons (OpenGL canvas).
+     * @see GERBER_DRAW_ITEM::CacheDrawGeometry()
+     */
+    void CacheDrawGeometry( const std::vector<int>& aLayers, bool aTriangulate );
+
 private:
     /**
      * When the image order has changed, call this to get a mapping
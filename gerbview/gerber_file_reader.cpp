@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gerber_file_reader.h>
+
+#include <cstring>
+
+#include <wx/ffile.h>
+
+
+GERBER_FILE_READER::GERBER_FILE_READER() :
+        m_pos( 0 )
+{
+    m_empty[0] = 0;
+    m_line = m_empty;
+}
+
+
+bool GERBER_FILE_READER::Open( const wxString& aFileName )
+{
+    Close();
+
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 )
+        return false;
+
+    m_data.resize( (size_t) length + 1 );
+
+    if( length > 0 && file.Read( m_data.data(), (size_t) length ) != (size_t) length )
+    {
+        Close();
+        return false;
+    }
+
+    m_data[length] = 0;
+
+    return true;
+}
+
+
+void GERBER_FILE_READER::Close()
+{
+    std::vector<char>().swap( m_data );
+    m_pos = 0;
+    m_line = m_empty;
+}
+
+
+char* GERBER_FILE_READER::ReadLine()
+{
+    // The last char of m_data is the terminating nul, which is not part of the file
+    if( m_data.empty() || m_pos >= m_data.size() - 1 )
+        return nullptr;
+
+    m_line = m_data.data() + m_pos;
+
+    size_t remaining = m_data.size() - 1 - m_pos;
+    char*  eol = static_cast<char*>( memchr( m_line, '\n', remaining ) );
+
+    if( eol )
+    {
+        *eol = 0;
+        m_pos = eol - m_data.data() + 1;
+    }
+    else
+    {
+        m_pos = m_data.size() - 1;
+    }
+
+    return m_line;
+}
@@ -0,0 +1,74 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GERBER_FILE_READER_H
+#define GERBER_FILE_READER_H
+
+#include <vector>
+
+class wxString;
+
+
+/**
+ * Read the lines of a gerber file.
+ *
+ * The whole file is read in memory in a single block, and the lines are returned in place:
+ * the line terminator is replaced by a nul char, so there is no copy of the line data and
+ * no limit on the line length.  A returned line stays valid until Close() is called.
+ */
+class GERBER_FILE_READER
+{
+public:
+    GERBER_FILE_READER();
+
+    /**
+     * Read the whole content of \a aFileName.
+     *
+     * @return false if the file cannot be read.
+     */
+    bool Open( const wxString& aFileName );
+
+    /**
+     * Release the file data.
+     */
+    void Close();
+
+    /**
+     * Return the next line of the file, without its line terminator, or nullptr at the end
+     * of file.
+     */
+    char* ReadLine();
+
+    /**
+     * Return the beginning of the last line returned by ReadLine(), or an empty string.
+     */
+    char* Line() const { return m_line; }
+
+private:
+    std::vector<char> m_data;       ///< the file content, followed by a nul char
+    size_t            m_pos;        ///< offset of the next line to read in m_data
+    char*             m_line;       ///< the last line read
+    char              m_empty[1];
+};
+
+#endif  // GERBER_FILE_READER_H
@@ -31,6 +31,7 @@
 
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <gerbview_settings.h>
 
 #include <functional>
 #include <memory>
@@ -145,6 +146,36 @@ bool GERBVIEW_DRAW_PANEL_GAL::SwitchBackend( GAL_TYPE aGalType )
 }
 
 
+void GERBVIEW_DRAW_PANEL_GAL::CacheLayerGeometry( const std::vector<int>& aLayers )
+{
+    GERBVIEW_FRAME* frame = dynamic_cast<GERBVIEW_FRAME*>( GetParentEDAFrame() );
+
+    // Like GERBVIEW_PAINTER, only triangulate polygons drawn filled with OpenGL
+    bool triangulate = m_backend == GAL_TYPE_OPENGL && frame
+                       && frame->gvconfig()->m_Display.m_DisplayPolygonsFill;
+
+    GERBER_FILE_IMAGE_LIST::GetImagesList().CacheDrawGeometry( aLayers, triangulate );
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::UpdateLayerItems( const std::vector<int>& aLayers,
+                                                int aUpdateFlags )
+{
+    CacheLayerGeometry( aLayers );
+
+    for( int layer : aLayers )
+    {
+        GERBER_FILE_IMAGE* gerber = GERBER_FILE_IMAGE_LIST::GetImagesList().GetGbrImage( layer );
+
+        if( gerber == nullptr )    // Graphic layer not yet used
+            continue;
+
+        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
+            m_view->Update( item, aUpdateFlags );
+    }
+}
+
+
 void GERBVIEW_DRAW_PANEL_GAL::setDefaultLayerDeps()
 {
     // caching makes no sense for Cairo and other software renderers
@@ -52,6 +52,23 @@ public:
     ///< @copydoc EDA_DRAW_PANEL_GAL::GetDefaultViewBBox()
     BOX2I GetDefaultViewBBox() const override;
 
+    /**
+     * Build the draw geometry of the items of some graphic layers on the thread pool, one task
+     * per layer, so that only the GAL tessellation is left to the view update.
+     *
+     * @param aLayers is the list of graphic layers (0 .. GERBER_DRAWLAYERS_COUNT-1).
+     */
+    void CacheLayerGeometry( const std::vector<int>& aLayers );
+
+    /**
+     * Update the view items of some graphic layers only, for instance after their image has
+     * been moved.  The cached GAL groups of the other layers are kept.
+     *
+     * @param aLayers is the list of graphic layers (0 .. GERBER_DRAWLAYERS_COUNT-1).
+     * @param aUpdateFlags is the KIGFX::VIEW_UPDATE_FLAGS to apply to the items.
+     */
+    void UpdateLayerItems( const std::vector<int>& aLayers, int aUpdateFlags );
+
     /**
      * Set or update the drawing-sheet (borders and title block) used by the draw panel.
      *
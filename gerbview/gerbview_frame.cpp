@@ -602,10 +602,9 @@ void GERBVIEW_FRAME::RemapLayers( const std::unordered_map<int, int>& remapping
     ReFillLayerWidget();
     syncLayerBox( true );
 
-    // Reordering draw layers need updating the view items
-    GetCanvas()->GetView()->RecacheAllItems();
-    GetCanvas()->GetView()->MarkDirty();
-    GetCanvas()->GetView()->UpdateAllItems( KIGFX::ALL );
+    // The cached groups were moved with their layer data, so only the rendering order of the
+    // layers (and the depth of the groups) has to follow the new layer order.
+    GetCanvas()->SetTopLayer( GERBER_DRAW_LAYER( GetActiveLayer() ) );
 
     GetCanvas()->Refresh();
 }
@@ -619,16 +618,36 @@ void GERBVIEW_FRAME::SetLayerDrawPrms()
     if( !gerber )
         return;
 
+    // The dialog can move several images: keep their current transform to find them afterwards
+    std::vector<std::pair<VECTOR2I, EDA_ANGLE>> prevTransforms( GERBER_DRAWLAYERS_COUNT );
+
+    for( int layer = 0; layer < GERBER_DRAWLAYERS_COUNT; ++layer )
+    {
+        if( GERBER_FILE_IMAGE* image = GetGbrImage( layer ) )
+            prevTransforms[layer] = { image->m_DisplayOffset, image->m_DisplayRotation };
+    }
+
     DIALOG_DRAW_LAYERS_SETTINGS dlg( this );
 
     if( dlg.ShowModal() != wxID_OK )
         return;
 
-    KIGFX::VIEW* view = GetCanvas()->GetView();
+    std::vector<int> changedLayers;
 
-    view->RecacheAllItems();
-    view->MarkDirty();
-    view->UpdateAllItems( KIGFX::ALL );
+    for( int layer = 0; layer < GERBER_DRAWLAYERS_COUNT; ++layer )
+    {
+        GERBER_FILE_IMAGE* image = GetGbrImage( layer );
+
+        if( image && ( image->m_DisplayOffset != prevTransforms[layer].first
+                       || image->m_DisplayRotation != prevTransforms[layer].second ) )
+        {
+            changedLayers.push_back( layer );
+        }
+    }
+
+    // Only the moved layers need their items (and their cached groups) to be rebuilt
+    GERBVIEW_DRAW_PANEL_GAL* canvas = static_cast<GERBVIEW_DRAW_PANEL_GAL*>( GetCanvas() );
+    canvas->UpdateLayerItems( changedLayers, KIGFX::GEOMETRY );
 
     GetCanvas()->Refresh();
 }
@@ -643,8 +662,13 @@ void GERBVIEW_FRAME::UpdateXORLayers()
 
     int lastVisibleLayer = -1;
 
+    // Layers which are not cached do not keep their groups up to date
+    std::vector<bool> wasCached( GERBER_DRAWLAYERS_COUNT );
+
     for( int i = 0; i < GERBER_DRAWLAYERS_COUNT; i++ )
     {
+        wasCached[i] = view->IsCached( GERBER_DRAW_LAYER( i ) );
+
         view->SetLayerDiff( GERBER_DRAW_LAYER( i ), gvconfig()->m_Display.m_XORMode );
 
         // Caching doesn't work with layered rendering of XOR'd layers
@@ -669,9 +693,19 @@ void GERBVIEW_FRAME::UpdateXORLayers()
         view->SetLayerDiff( GERBER_DRAW_LAYER( lastVisibleLayer ), false );
     }
 
-    view->RecacheAllItems();
+    // Only rebuild the groups of the layers becoming cached, the other cached layers are
+    // still valid
+    std::vector<int> recacheLayers;
+
+    for( int i = 0; i < GERBER_DRAWLAYERS_COUNT; i++ )
+    {
+        if( !wasCached[i] && view->IsCached( GERBER_DRAW_LAYER( i ) ) )
+            recacheLayers.push_back( i );
+    }
+
+    GERBVIEW_DRAW_PANEL_GAL* canvas = static_cast<GERBVIEW_DRAW_PANEL_GAL*>( GetCanvas() );
+    canvas->UpdateLayerItems( recacheLayers, KIGFX::REPAINT );
     view->MarkDirty();
-    view->UpdateAllItems( KIGFX::ALL );
 }
 
 
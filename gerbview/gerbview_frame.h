@@ -173,6 +173,13 @@ public:
      */
     int getNextAvailableLayer() const;
 
+    /**
+     * Show the messages collected while reading \a aImage and add its items to the view.
+     *
+     * @param aImage is an image which has just been read and added to the images list.
+     */
+    void finishImageLoad( GERBER_FILE_IMAGE* aImage );
+
     /**
      * Update the currently "selected" layer within the #GERBER_LAYER_WIDGET.
      * The currently active layer is defined by the return value of GetActiveLayer().
@@ -261,35 +261,18 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
         if( !isFilled )
             m_gal->SetLineWidth( m_gerbviewSettings.m_outlineWidth );
 
-        if( aItem->m_AbsolutePolygon.OutlineCount() == 0 )
-        {
-            std::vector<VECTOR2I> pts = aItem->m_ShapeAsPolygon.COutline( 0 ).CPoints();
-
-            for( auto& pt : pts )
-                pt = aItem->GetABPosition( pt );
-
-            SHAPE_LINE_CHAIN chain( pts );
-            chain.SetClosed( true );
-            aItem->m_AbsolutePolygon.AddOutline( chain );
-        }
+        // On Opengl, a not convex filled polygon is usually drawn by using triangles as
+        // primitives, so the triangulation is cached with the absolute polygon.
+        // This is usually already done for the whole layer on the thread pool, see
+        // GERBER_FILE_IMAGE_LIST::CacheDrawGeometry()
+        aItem->CacheDrawGeometry( isFilled && m_gal->IsOpenGlEngine() );
 
         // Degenerated polygons (having < 3 points) are drawn as lines
         // to avoid issues in draw polygon functions
         if( !isFilled || aItem->m_AbsolutePolygon.COutline( 0 ).PointCount() < 3 )
             m_gal->DrawPolyline( aItem->m_AbsolutePolygon.COutline( 0 ) );
         else
-        {
-            // On Opengl, a not convex filled polygon is usually drawn by using triangles as
-            // primitives. CacheTriangulation() can create basic triangle primitives to draw the
-            // polygon solid shape on Opengl
-            // We use the fastest CacheTriangulation calculation mode: no partition created because
-            // the partition is useless in Gerbview, and very time consumming (optimized only
-            // for pcbnew that has different internal unit)
-            if( m_gal->IsOpenGlEngine() && !aItem->m_AbsolutePolygon.IsTriangulationUpToDate() )
-                aItem->m_AbsolutePolygon.CacheTriangulation( false /* fastest triangulation calculation mode */ );
-
             m_gal->DrawPolygon( aItem->m_AbsolutePolygon );
-        }
 
         break;
     }
@@ -567,12 +550,7 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
 
 void GERBVIEW_PAINTER::drawApertureMacro( GERBER_DRAW_ITEM* aParent, bool aFilled )
 {
-    if( aParent->m_AbsolutePolygon.OutlineCount() == 0 )
-    {
-        D_CODE* code = aParent->GetDcodeDescr();
-        APERTURE_MACRO* macro = code->GetMacro();
-        aParent->m_AbsolutePolygon = *macro->GetApertureMacroShape( aParent, aParent->m_Start );
-    }
+    aParent->CacheDrawGeometry( false );
 
     SHAPE_POLY_SET& polyset = aParent->m_AbsolutePolygon;
 
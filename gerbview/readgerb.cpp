@@ -71,42 +71,7 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
     wxASSERT( gerber != nullptr );
     images->AddGbrImage( gerber, layer );
 
-    // Display errors list
-    if( gerber->GetMessages().size() > 0 )
-    {
-        HTML_MESSAGE_BOX dlg( this, _( "Errors" ) );
-        dlg.ListSet( gerber->GetMessages() );
-        dlg.ShowModal();
-    }
-
-    /* if the gerber file has items using D codes but missing D codes definitions,
-     * it can be a deprecated RS274D file (i.e. without any aperture information),
-     * or has missing definitions,
-     * warn the user:
-     */
-    if( gerber->GetItemsCount() && gerber->m_Has_MissingDCode )
-    {
-        if( !gerber->m_Has_DCode )
-            msg = _("Warning: this file has no D-Code definition\n"
-                    "Therefore the size of some items is undefined");
-        else
-            msg = _("Warning: this file has some missing D-Code definitions\n"
-                    "Therefore the size of some items is undefined");
-
-        wxMessageBox( msg );
-    }
-
-    if( GetCanvas() )
-    {
-        if( gerber->m_ImageNegative )
-        {
-            // TODO: find a way to handle negative images
-            // (maybe convert geometry into positives?)
-        }
-
-        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
-            GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
-    }
+    finishImageLoad( gerber );
 
     return true;
 }
@@ -225,9 +190,6 @@ bool GERBER_FILE_IMAGE::TestFileIsRS274( const wxString& aFullFileName )
 }
 
 
-// A large buffer to store one line
-char GERBER_FILE_IMAGE::m_LineBuffer[GERBER_BUFZ+1];
-
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
     int      G_command = 0;        // command number for G commands like G04
@@ -238,9 +200,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     ResetDefaultValues();
 
     // Read the gerber file */
-    m_Current_File = wxFopen( aFullFileName, wxT( "rt" ) );
-
-    if( m_Current_File == nullptr )
+    if( !m_reader.Open( aFullFileName ) )
         return false;
 
     m_FileName = aFullFileName;
@@ -251,11 +211,11 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     while( true )
     {
-        if( fgets( m_LineBuffer, GERBER_BUFZ, m_Current_File ) == nullptr )
+        if( m_reader.ReadLine() == nullptr )
             break;
 
         m_LineNum++;
-        text = StrPurge( m_LineBuffer );
+        text = StrPurge( m_reader.Line() );
 
         while( text && *text )
         {
@@ -312,7 +272,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
                 if( m_CommandState != ENTER_RS274X_CMD )
                 {
                     m_CommandState = ENTER_RS274X_CMD;
-                    ReadRS274XCommand( m_LineBuffer, GERBER_BUFZ, text );
+                    ReadRS274XCommand( text );
                 }
                 else        //Error
                 {
@@ -331,7 +291,8 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
         }
     }
 
-    fclose( m_Current_File );
+    // Release the file data: it is only needed while reading
+    m_reader.Close();
 
     m_InUse = true;
 
@@ -110,7 +110,7 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     aGbrItem->m_DCode = Dcode_index;
     aGbrItem->SetLayerPolarity( aLayerNegative );
     aGbrItem->m_Flashed = true;
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     switch( aAperture )
     {
@@ -132,12 +132,19 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
         break;
 
     case APT_MACRO:
+    {
         aGbrItem->m_ShapeType = GBR_SPOT_MACRO;
 
-        // Cache the bounding box for aperture macros
-        aGbrItem->GetDcodeDescr()->GetMacro()->GetApertureMacroShape( aGbrItem, aPos );
+        // Cache the bounding box for aperture macros.  The macro shape only depends on the
+        // D_CODE and its parameters, so it is built once for all the flashes of this D_CODE
+        D_CODE* dcode = aGbrItem->GetDcodeDescr();
+
+        if( dcode->m_Polygon.OutlineCount() == 0 )
+            dcode->ConvertShapeToPolygon( aGbrItem );
+
         break;
     }
+    }
 }
 
 
@@ -168,7 +175,7 @@ void fillLineGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     aGbrItem->m_DCode = Dcode_index;
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 }
 
 
@@ -211,7 +218,7 @@ void fillArcGBRITEM( GERBER_DRAW_ITEM* aGbrItem, int Dcode_index, const VECTOR2I
     aGbrItem->m_Flashed = false;
 
     if( aGbrItem->m_GerberImageFile )
-        aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+        aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     if( aMultiquadrant )
     {
@@ -333,14 +340,15 @@ static void fillArcPOLY( GERBER_DRAW_ITEM* aGbrItem, const VECTOR2I& aStart, con
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( nullptr );
+    // thread_local: several files can be parsed at the same time
+    static thread_local GERBER_DRAW_ITEM dummyGbrItem( nullptr );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
     fillArcGBRITEM( &dummyGbrItem, 0, aStart, aEnd, rel_center, VECTOR2I( 0, 0 ),
                     aClockwise, aMultiquadrant, aLayerNegative );
 
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     VECTOR2I center;
     center = dummyGbrItem.m_ArcCentre;
@@ -465,10 +473,10 @@ bool GERBER_FILE_IMAGE::Execute_G_Command( char*& text, int G_command )
 
             char* cptr = (char*)x2buf.data();
             int code_command = ReadXCommandID( cptr );
-            ExecuteRS274XCommand( code_command, nullptr, 0, cptr );
+            ExecuteRS274XCommand( code_command, cptr );
         }
 
-        GetEndOfBlock( m_LineBuffer, GERBER_BUFZ, text, m_Current_File );
+        GetEndOfBlock( text );
 
         break;
 
@@ -608,7 +616,8 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
 
                 if( gbritem->m_GerberImageFile )
                 {
-                    gbritem->SetNetAttributes( gbritem->m_GerberImageFile->m_NetAttributeDict );
+                    gbritem->SetNetAttributes(
+                            gbritem->m_GerberImageFile->GetSharedNetAttributes() );
                     gbritem->m_AperFunction = gbritem->m_GerberImageFile->m_AperFunction;
                 }
             }
@@ -139,7 +139,7 @@ int GERBER_FILE_IMAGE::ReadXCommandID( char*& text )
 }
 
 
-bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText )
+bool GERBER_FILE_IMAGE::ReadRS274XCommand( char*& aText )
 {
     bool ok = true;
     int  code_command;
@@ -169,7 +169,7 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
 
             default:
                 code_command = ReadXCommandID( aText );
-                ok = ExecuteRS274XCommand( code_command, aBuff, aBuffSize, aText );
+                ok = ExecuteRS274XCommand( code_command, aText );
 
                 if( !ok )
                     goto exit;
@@ -179,14 +179,14 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
         }
 
         // end of current line, read another one.
-        if( fgets( aBuff, aBuffSize, m_Current_File ) == nullptr )
+        if( m_reader.ReadLine() == nullptr )
         {
             // end of file
             ok = false;
             break;
         }
         m_LineNum++;
-        aText = aBuff;
+        aText = m_reader.Line();
     }
 
 exit:
@@ -194,8 +194,7 @@ exit:
 }
 
 
-bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
-                                              unsigned int aBuffSize, char*& aText )
+bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char*& aText )
 {
     int      code;
     int      seq_len;    // not used, just provided
@@ -227,7 +226,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
             case 'D':       // Non-standard option for all zeros (leading + tailing)
                 msg.Printf( _( "RS274X: Invalid GERBER format command '%c' at line %d: \"%s\"" ),
-                        'D', m_LineNum, aBuff );
+                        'D', m_LineNum, m_reader.Line() );
                 AddMessageToList( msg );
                 msg.Printf( _("GERBER file \"%s\" may not display as intended." ),
                         m_FileName.ToAscii() );
@@ -322,7 +321,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
                 msg.Printf( wxT( "Unknown id (%c) in FS command" ),
                            *aText );
                 AddMessageToList( msg );
-                GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+                GetEndOfBlock( aText );
                 ok = false;
                 break;
             }
@@ -385,7 +384,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case FILE_ATTRIBUTE:    // Command %TF ...
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_reader, aText, m_LineNum );
 
         if( dummy.IsFileFunction() )
         {
@@ -410,7 +409,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case APERTURE_ATTRIBUTE:    // Command %TA
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_reader, aText, m_LineNum );
 
         if( dummy.GetAttribute() == wxT( ".AperFunction" ) )
         {
@@ -427,7 +426,10 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     {
         X2_ATTRIBUTE dummy;
 
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_reader, aText, m_LineNum );
+
+        // The items created from now on use the new attributes
+        m_sharedNetAttributes.reset();
 
         if( dummy.GetAttribute() == wxT( ".N" ) )
         {
@@ -461,7 +463,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case REMOVE_APERTURE_ATTRIBUTE:    // Command %TD ...
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_reader, aText, m_LineNum );
         RemoveAttribute( dummy );
     }
         break;
@@ -701,7 +703,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case AP_MACRO:  // lines like %AMMYMACRO*
                     // 5,1,8,0,0,1.08239X$1,22.5*
                     // %
-        /*ok = */ReadApertureMacro( aBuff, aBuffSize, aText, m_Current_File );
+        /*ok = */ReadApertureMacro( aText );
         break;
 
     case AP_DEFINITION:
@@ -922,17 +924,17 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
     ignore_unused( seq_len );
 
-    ok = GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+    ok = GetEndOfBlock( aText );
 
     return ok;
 }
 
 
-bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* gerber_file )
+bool GERBER_FILE_IMAGE::GetEndOfBlock( char*& aText )
 {
     for( ; ; )
     {
-        while( (aText < aBuff + aBuffSize) && *aText )
+        while( *aText )
         {
             if( *aText == '*' )
                 return true;
@@ -943,18 +945,20 @@ bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char
             aText++;
         }
 
-        if( fgets( aBuff, aBuffSize, gerber_file ) == nullptr )
+        char* line = m_reader.ReadLine();
+
+        if( line == nullptr )
             break;
 
         m_LineNum++;
-        aText = aBuff;
+        aText = line;
     }
 
     return false;
 }
 
 
-char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile )
+char* GERBER_FILE_IMAGE::GetNextLine( char* aText )
 {
     for( ; ; )
     {
@@ -966,12 +970,13 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
                 ++aText;
                 break;
 
-            case 0:    // End of text found in aBuff: Read a new string
-                if( fgets( aBuff, aBuffSize, aFile ) == nullptr )
+            case 0:    // End of text found in the current line: Read a new line
+                aText = m_reader.ReadLine();
+
+                if( aText == nullptr )
                     return nullptr;
 
                 m_LineNum++;
-                aText = aBuff;
                 return aText;
 
             default:
@@ -981,9 +986,7 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
 }
 
 
-bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
-                                char*&    aText,
-                                FILE*     gerber_file )
+bool GERBER_FILE_IMAGE::ReadApertureMacro( char*& aText )
 {
     wxString       msg;
     APERTURE_MACRO am;
@@ -1006,7 +1009,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         if( *aText == '*' )
             ++aText;
 
-        aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+        aText = GetNextLine( aText );
 
         if( aText == nullptr )  // End of File
             return false;
@@ -1032,7 +1035,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         {
             am.AddLocalParamDefToStack();
             AM_PARAM& param = am.GetLastLocalParamDefFromStack();
-            aText = GetNextLine(  aBuff, aBuffSize, aText, gerber_file );
+            aText = GetNextLine( aText );
 
             if( aText == nullptr)   // End of File
                 return false;
@@ -1043,7 +1046,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         else if( !isdigit(*aText)  )     // Ill. symbol
         {
             msg.Printf( wxT( "RS274X: Aperture Macro \"%s\": ill. symbol, line: \"%s\"" ),
-                        am.m_AmName, From_UTF8( aBuff ) );
+                        am.m_AmName, From_UTF8( m_reader.Line() ) );
             AddMessageToList( msg );
             primitive_type = AMP_COMMENT;
         }
@@ -1059,7 +1062,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
             is_comment = true;
 
             // Skip comment
-            GetEndOfBlock( m_LineBuffer, GERBER_BUFZ, aText, m_Current_File );
+            GetEndOfBlock( aText );
 
             break;
 
@@ -1096,7 +1099,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
         default:
             msg.Printf( wxT( "RS274X: Aperture Macro \"%s\": Invalid primitive id code %d, line %d: \"%s\"" ),
-                        am.m_AmName, primitive_type, m_LineNum, From_UTF8( aBuff ) );
+                        am.m_AmName, primitive_type, m_LineNum, From_UTF8( m_reader.Line() ) );
             AddMessageToList( msg );
             return false;
         }
@@ -1114,7 +1117,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
             AM_PARAM& param = prim.m_Params.back();
 
-            aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+            aText = GetNextLine( aText );
 
             if( aText == nullptr)   // End of File
                 return false;
@@ -1149,7 +1152,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
                 AM_PARAM& param = prim.m_Params.back();
 
-                aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+                aText = GetNextLine( aText );
 
                 if( aText == nullptr )  // End of File
                     return false;
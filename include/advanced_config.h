@@ -308,6 +308,17 @@ public:
      */
     bool m_DebugPDFWriter;
 
+    /**
+     * The zlib compression level of the page and image streams in PDF plots.
+     *
+     * Lower levels make large multi-page plots noticeably faster at the cost of bigger files.
+     *
+     * Setting name: "PDFCompressionLevel"
+     * Valid values: 0 (no compression) to 9 (best compression)
+     * Default value: 9
+     */
+    int m_PDFCompressionLevel;
+
     /**
      * The diameter of the drill marks on print and plot outputs (in mm) when the "Drill marks"
      * option is set to "Small mark".
@@ -369,6 +380,19 @@ public:
      */
     bool m_Skip3DModelMemoryCache;
 
+    /**
+     * The maximum number of parsed footprints kept in memory for each footprint library.
+     *
+     * Footprint files are parsed when first used; once the limit is reached the least recently
+     * used footprints are released and will be parsed again when needed.  A value of 0 keeps
+     * every parsed footprint.
+     *
+     * Setting name: "FootprintCacheSize"
+     * Valid values: 0 to 100000
+     * Default value: 500
+     */
+    int m_FootprintCacheSize;
+
     /**
      * Hide the build version from the KiCad manager frame title.
      *
@@ -398,6 +422,18 @@ public:
      */
     bool m_ShowEventCounters;
 
+    /**
+     * Record per-frame drawing statistics (redraw time, per-layer item counts and R-tree query
+     * times, draw calls, vertices and GPU upload size) and show them in an overlay on the
+     * canvas.  The recorded frames are written to gal_frame_stats.csv in the user cache
+     * directory when the canvas is closed.
+     *
+     * Setting name: "ShowGalFrameStats"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_ShowGalFrameStats;
+
     /**
      * Allow manual scaling of canvas.
      *
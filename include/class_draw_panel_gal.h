@@ -246,6 +246,20 @@ public:
      */
     void ClearDebugOverlay();
 
+    /**
+     * Enable or disable recording of per-frame drawing statistics and the overlay showing them.
+     */
+    void SetShowFrameStats( bool aShow );
+
+    bool IsShowingFrameStats() const { return m_frameStatsOverlay != nullptr; }
+
+    /**
+     * Write the recorded per-frame drawing statistics to a CSV file.
+     *
+     * @return false if the file could not be written.
+     */
+    bool ExportFrameStats( const wxString& aFileName );
+
 
     /**
      * Gets a populated View Controls settings object dervived from our program settings
@@ -322,6 +336,9 @@ protected:
 
     /// Optional overlay for drawing transient debug objects
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
+
+    /// Overlay showing the drawing statistics of the last frames (if enabled)
+    std::shared_ptr<KIGFX::VIEW_OVERLAY> m_frameStatsOverlay;
 };
 
 #endif
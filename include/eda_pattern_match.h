@@ -30,6 +30,9 @@
 #define EDA_PATTERN_MATCH_H
 
 #include <kicommon.h>
+#include <array>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <map>
 #include <memory>
@@ -58,6 +61,32 @@ struct KICOMMON_API SEARCH_TERM
 };
 
 
+/*
+ * Search terms prepared for repeated scoring by EDA_COMBINED_MATCHER: lowercased UTF-32 copies
+ * of the term texts and a bitmap of the trigrams found in them.  Items whose bitmap lacks one of
+ * the trigrams of a plain substring pattern cannot match it and are ruled out without looking
+ * at their text.
+ */
+struct KICOMMON_API PREPARED_SEARCH_TERMS
+{
+    typedef std::array<uint64_t, 4> TRIGRAM_BITS;
+
+    /**
+     * Normalize \a aTerms in place, as EDA_COMBINED_MATCHER::ScoreTerms() would do, and store
+     * their prepared copies.
+     */
+    void Prepare( std::vector<SEARCH_TERM>& aTerms );
+
+    /**
+     * Set the bits of all the trigrams of \a aText in \a aBits.
+     */
+    static void AddTrigrams( const std::u32string& aText, TRIGRAM_BITS& aBits );
+
+    std::vector<std::u32string> Texts;
+    TRIGRAM_BITS                Trigrams = {};
+};
+
+
 /*
  * Interface for a pattern matcher, for which there are several implementations
  */
@@ -243,12 +272,27 @@ public:
 
     int ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms );
 
+    /**
+     * Score \a aWeightedTerms, which must have been prepared into \a aPrepared.
+     *
+     * Gives the same result as ScoreTerms( aWeightedTerms ), but patterns which can only match
+     * as plain substrings are checked against the trigrams and the UTF-32 texts of \a aPrepared
+     * rather than run through the pattern matchers.
+     */
+    int ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms,
+                    const PREPARED_SEARCH_TERMS& aPrepared );
+
 private:
     // Add matcher if it can compile the pattern.
     void AddMatcher( const wxString& aPattern, std::unique_ptr<EDA_PATTERN_MATCH> aMatcher );
 
     std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_matchers;
     wxString m_pattern;
+
+    bool                                m_isSubstring;  // All matchers reduce to a substring
+                                                        // search for this pattern
+    std::u32string                      m_pattern32;
+    PREPARED_SEARCH_TERMS::TRIGRAM_BITS m_patternTrigrams;
 };
 
 #endif  // EDA_PATTERN_MATCH_H
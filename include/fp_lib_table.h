@@ -29,6 +29,8 @@
 #include <lib_table_base.h>
 #include <pcb_io/pcb_io_mgr.h>
 
+#include <functional>
+
 class FOOTPRINT;
 class FP_LIB_TABLE_GRID;
 class PCB_IO;
@@ -194,6 +196,17 @@ public:
      */
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aNickname,
                                              const wxString& aFootprintName );
+
+    /**
+     * Call \a aVisitor with a footprint after #FootprintEnumerate(), without asking the library
+     * to keep the footprint in memory afterwards.
+     *
+     * @return false if the footprint was not found.
+     * @throw IO_ERROR if the footprint cannot be read.
+     */
+    bool VisitEnumeratedFootprint( const wxString& aNickname, const wxString& aFootprintName,
+                                   const std::function<void( const FOOTPRINT& )>& aVisitor );
+
     /**
      * The set of return values from FootprintSave() below.
      */
@@ -51,6 +51,24 @@ enum RENDER_TARGET
     TARGET_TEMP,            ///< Temporary target for drawing in separate layer
     TARGETS_NUMBER          ///< Number of available rendering targets
 };
+
+/**
+ * Counters collected by the GAL backend while drawing a frame.
+ */
+struct GAL_DRAW_STATS
+{
+    unsigned long long drawCalls   = 0;  ///< Number of draw calls issued to the backend
+    unsigned long long vertices    = 0;  ///< Number of vertices submitted for drawing
+    unsigned long long uploadBytes = 0;  ///< Bytes of vertex data transferred to the GPU
+
+    GAL_DRAW_STATS& operator+=( const GAL_DRAW_STATS& aOther )
+    {
+        drawCalls += aOther.drawCalls;
+        vertices += aOther.vertices;
+        uploadBytes += aOther.uploadBytes;
+        return *this;
+    }
+};
 } // namespace KIGFX
 
 #endif /* DEFINITIONS_H_ */
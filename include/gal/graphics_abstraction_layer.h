@@ -659,6 +659,17 @@ public:
         return true;
     };
 
+    /**
+     * Return the draw calls, vertices and uploaded bytes counted since the last call to
+     * ResetDrawStats().  Backends that do not collect these counters return zeros.
+     */
+    virtual GAL_DRAW_STATS GetDrawStats() const { return GAL_DRAW_STATS(); }
+
+    /**
+     * Reset the draw counters returned by GetDrawStats().
+     */
+    virtual void ResetDrawStats() {}
+
     /**
      * Set negative draw mode in the renderer.
      *
@@ -59,6 +59,12 @@ public:
         return true;
     }
 
+    ///< Vertices up to the highest used index, i.e. the range transferred by Unmap()
+    unsigned int AllItemsSize() const override
+    {
+        return m_maxIndex;
+    }
+
     /**
      * Return handle to the vertex buffer.
      *
@@ -27,6 +27,7 @@
 #ifndef GPU_MANAGER_H_
 #define GPU_MANAGER_H_
 
+#include <gal/definitions.h>
 #include <vector>
 #include <gal/opengl/vertex_common.h>
 #include <boost/scoped_array.hpp>
@@ -79,6 +80,13 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Return the draw counters accumulated since the last call to ResetDrawStats().
+     */
+    const GAL_DRAW_STATS& GetDrawStats() const { return m_drawStats; }
+
+    void ResetDrawStats() { m_drawStats = GAL_DRAW_STATS(); }
+
 protected:
     GPU_MANAGER( VERTEX_CONTAINER* aContainer );
 
@@ -96,6 +104,9 @@ protected:
 
     ///< true: enable Z test when drawing
     bool m_enableDepthTest;
+
+    ///< Draw calls, vertices and uploaded bytes since the last reset
+    GAL_DRAW_STATS m_drawStats;
 };
 
 
@@ -260,6 +260,12 @@ public:
     /// @copydoc GAL::HasTarget()
     virtual bool HasTarget( RENDER_TARGET aTarget ) override;
 
+    /// @copydoc GAL::GetDrawStats()
+    GAL_DRAW_STATS GetDrawStats() const override;
+
+    /// @copydoc GAL::ResetDrawStats()
+    void ResetDrawStats() override;
+
     /// @copydoc GAL::SetNegativeDrawMode()
     void SetNegativeDrawMode( bool aSetting ) override {}
 
@@ -35,6 +35,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/glm.hpp>
 #include <gal/opengl/vertex_common.h>
+#include <gal/definitions.h>
 #include <gal/color4d.h>
 #include <stack>
 #include <memory>
@@ -347,6 +348,13 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Return the draw counters collected by the GPU manager since the last reset.
+     */
+    const GAL_DRAW_STATS& GetDrawStats() const;
+
+    void ResetDrawStats();
+
 protected:
     /**
      * Apply all transformation to the given coordinates and store them at the specified target.
@@ -69,6 +69,7 @@
  * - `Desc` - description of the alias, to be displayed
  * - `m_MatchName` - Name, normalized to lowercase for matching
  * - `m_SearchText` - normalized composite of keywords and description
+ * - `m_PreparedTerms` - search terms prepared once for fast scoring
  * - `LibId` - the #LIB_ID this alias or unit is from, or not valid
  * - `Unit` - the unit number, or zero for non-units
  */
@@ -142,6 +143,7 @@ public:
     int         m_PinCount;    // Pin count from symbol, or unique pad count from footprint
 
     std::vector<SEARCH_TERM>     m_SearchTerms;    /// List of weighted search terms
+    PREPARED_SEARCH_TERMS        m_PreparedTerms;  /// m_SearchTerms prepared for scoring
     std::map<wxString, wxString> m_Fields;         /// @see LIB_TREE_ITEMS::GetChooserFields
 
     LIB_ID      m_LibId;       // LIB_ID determined by the parent library nickname and alias name.
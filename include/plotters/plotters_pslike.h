@@ -27,6 +27,9 @@
 
 #include "plotter.h"
 
+#include <deque>
+#include <future>
+
 
 /**
  * The PSLIKE_PLOTTER class is an intermediate class to handle common routines for engines
@@ -244,6 +247,7 @@ public:
             m_imgResDictHandle( 0 ),
             m_jsNamesHandle( 0 ),
             m_pageStreamHandle( 0 ),
+            m_streamHandle( 0 ),
             m_streamLengthHandle( 0 ),
             m_workFile( nullptr ),
             m_totalOutlineNodes( 0 )
@@ -461,10 +465,19 @@ protected:
     int startPdfStream(int handle = -1);
 
     /**
-     * Finish the current PDF stream (writes the deferred length, too)
+     * Finish the current PDF stream.
+     *
+     * The stream content is compressed on the thread pool; the stream object (and its deferred
+     * length) is written by writePendingStreams(), in the order the streams were closed.
      */
     void closePdfStream();
 
+    /**
+     * Write the closed streams to the output file, waiting for their compression, until no
+     * more than \a aMaxPending of them are left.
+     */
+    void writePendingStreams( size_t aMaxPending );
+
     /**
      * Starts emitting the outline object
      */
@@ -489,6 +502,7 @@ protected:
     int m_jsNamesHandle;            ///< Handle for Names dictionary with JS
     std::vector<int> m_pageHandles; ///< Handles to the page objects
     int m_pageStreamHandle;         ///< Handle of the page content object
+    int m_streamHandle;             ///< Handle of the stream being built
     int m_streamLengthHandle;       ///< Handle to the deferred stream length
     wxString m_workFilename;
     wxString m_pageName;
@@ -510,6 +524,15 @@ protected:
 
     std::map<int, wxImage> m_imageHandles;
 
+    struct PENDING_STREAM
+    {
+        int                      m_handle;
+        int                      m_lengthHandle;
+        std::future<std::string> m_data;        ///< The stream content, once compressed
+    };
+
+    std::deque<PENDING_STREAM> m_pendingStreams;   ///< Closed streams not yet written
+
     std::unique_ptr<OUTLINE_NODE> m_outlineRoot;    ///< Root outline node
     int                           m_totalOutlineNodes;  ///< Total number of outline nodes
 };
@@ -26,6 +26,7 @@
 #include <set>
 #include <memory>
 #include <map>
+#include <mutex>
 
 #include <netclass.h>
 #include <settings/nested_settings.h>
@@ -220,6 +221,10 @@ private:
     /// @brief Cache of nets to pattern-matched netclasses
     std::map<wxString, std::shared_ptr<NETCLASS>> m_effectiveNetclassCache;
 
+    /// @brief Guards the effective, composite and implicit netclasses, which are filled lazily
+    /// and may be resolved from several threads at once (e.g. by the ERC tests)
+    mutable std::mutex m_effectiveNetclassMutex;
+
     /**
      * A map of fully-qualified net names to colors used in the board context.
      * Since these color overrides are for the board, buses are not included here.
@@ -37,6 +37,7 @@
 #include <gal/definitions.h>
 
 #include <view/view_overlay.h>
+#include <view/view_frame_stats.h>
 #include <view/view.h>
 
 namespace KIGFX
@@ -717,6 +718,11 @@ public:
 
     std::shared_ptr<VIEW_OVERLAY> MakeOverlay();
 
+    /**
+     * Return the per-frame drawing statistics (disabled by default).
+     */
+    VIEW_FRAME_STATS& GetFrameStats() { return m_frameStats; }
+
     void InitPreview();
 
     void ClearPreview();
@@ -889,6 +895,9 @@ protected:
 
     ///< Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
+
+    ///< Ring buffer of per-frame drawing statistics.
+    VIEW_FRAME_STATS m_frameStats;
 };
 } // namespace KIGFX
 
@@ -0,0 +1,144 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __VIEW_FRAME_STATS_H
+#define __VIEW_FRAME_STATS_H
+
+#include <gal/gal.h>
+#include <gal/definitions.h>
+
+#include <vector>
+
+class wxString;
+
+namespace KIGFX
+{
+class VIEW;
+class VIEW_OVERLAY;
+
+/**
+ * Drawing statistics of a single VIEW layer within one frame.
+ */
+struct VIEW_LAYER_FRAME_STATS
+{
+    int      layer   = -1;   ///< VIEW layer id
+    unsigned items   = 0;    ///< Number of items drawn on the layer
+    double   queryMs = 0.0;  ///< Time spent in the R-tree query (including drawing callbacks)
+};
+
+
+/**
+ * Statistics collected for a single redraw of the VIEW.
+ */
+struct VIEW_FRAME_RECORD
+{
+    unsigned long long                  frame    = 0;    ///< Sequential frame number
+    double                              redrawMs = 0.0;  ///< Time spent in VIEW::redrawRect()
+    GAL_DRAW_STATS                      gal;             ///< Counters reported by the GAL
+    std::vector<VIEW_LAYER_FRAME_STATS> layers;          ///< Per-layer item counts and timings
+
+    unsigned TotalItems() const;
+    double   TotalQueryMs() const;
+};
+
+
+/**
+ * Ring buffer of per-frame drawing statistics gathered by the VIEW.
+ *
+ * Recording is off by default.  When enabled, every redraw of the cached/non-cached targets
+ * adds a #VIEW_FRAME_RECORD; the oldest records are overwritten once the buffer is full.
+ * Overlay-only refreshes are not recorded, so the statistics overlay can update itself without
+ * triggering an endless chain of repaints.
+ */
+class GAL_API VIEW_FRAME_STATS
+{
+public:
+    VIEW_FRAME_STATS( size_t aCapacity = DEFAULT_CAPACITY );
+
+    void SetEnabled( bool aEnabled ) { m_enabled = aEnabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    /**
+     * @return true between BeginFrame() and EndFrame().
+     */
+    bool IsRecording() const { return m_recording; }
+
+    /**
+     * Start a new frame record.  Does nothing if the statistics are disabled.
+     */
+    void BeginFrame();
+
+    void AddLayer( int aLayer, unsigned aItems, double aQueryMs );
+
+    void SetRedrawTime( double aMs ) { m_current.redrawMs = aMs; }
+
+    /**
+     * Store the frame being recorded in the ring buffer.
+     *
+     * @param aGalStats are the GAL counters for the frame (known only after the GAL has
+     *                  finished drawing).
+     */
+    void EndFrame( const GAL_DRAW_STATS& aGalStats );
+
+    void Clear();
+
+    /**
+     * @return the number of frames stored in the buffer.
+     */
+    size_t GetCount() const { return m_count; }
+
+    /**
+     * @param aIndex is the age-ordered index, 0 being the oldest stored frame.
+     */
+    const VIEW_FRAME_RECORD& GetFrame( size_t aIndex ) const;
+
+    /**
+     * Write all the stored frames as CSV, one row per drawn layer of each frame.
+     *
+     * @return false if the file could not be written.
+     */
+    bool WriteCsv( const wxString& aFileName ) const;
+
+    /**
+     * Replace the contents of \a aOverlay with a textual summary of the recorded frames,
+     * placed in the top-left corner of \a aView.
+     */
+    void DrawOverlay( VIEW_OVERLAY& aOverlay, const VIEW& aView ) const;
+
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+private:
+    std::vector<VIEW_FRAME_RECORD> m_frames;
+    size_t                         m_first;
+    size_t                         m_count;
+
+    VIEW_FRAME_RECORD              m_current;
+    unsigned long long             m_frameCounter;
+
+    bool                           m_enabled;
+    bool                           m_recording;
+};
+
+} // namespace KIGFX
+
+#endif
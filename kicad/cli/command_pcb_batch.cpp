@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_batch.h"
+#include "command_pcb_drc.h"
+#include "command_pcb_export_3d.h"
+#include "command_pcb_export_drill.h"
+#include "command_pcb_export_dxf.h"
+#include "command_pcb_export_gerber.h"
+#include "command_pcb_export_gerbers.h"
+#include "command_pcb_export_ipc2581.h"
+#include "command_pcb_export_pdf.h"
+#include "command_pcb_export_pos.h"
+#include "command_pcb_export_svg.h"
+#include "command_pcb_render.h"
+#include <cli/exit_codes.h>
+#include <locale_io.h>
+#include <macros.h>
+#include <string_utils.h>
+
+#include <wx/cmdline.h>
+#include <wx/crt.h>
+#include <wx/file.h>
+#include <wx/textfile.h>
+
+#include <map>
+#include <memory>
+
+#define ARG_JOBS "--jobs"
+
+
+CLI::PCB_BATCH_COMMAND::PCB_BATCH_COMMAND() : COMMAND( "batch" )
+{
+    addCommonArgs( true, false, false, false );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Run several pcb commands on a board, loading "
+                                                "the board only once" ) ) );
+
+    m_argParser.add_argument( ARG_JOBS )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "File listing the commands to run, one per line, written as "
+                                  "after 'kicad-cli pcb' but without the input file (for "
+                                  "instance 'export gerbers -o gerbers/'); empty lines and "
+                                  "lines starting with '#' are ignored" ) ) )
+            .metavar( "JOBS_FILE" );
+}
+
+
+/**
+ * Create the command for the first words of \a aArgs; \a aConsumed is set to the number of
+ * words naming the command.
+ */
+static std::unique_ptr<CLI::COMMAND> createCommand( const wxArrayString& aArgs,
+                                                    size_t& aConsumed )
+{
+    if( aArgs.empty() )
+        return nullptr;
+
+    aConsumed = 1;
+
+    if( aArgs[0] == wxS( "drc" ) )
+        return std::make_unique<CLI::PCB_DRC_COMMAND>();
+    else if( aArgs[0] == wxS( "render" ) )
+        return std::make_unique<CLI::PCB_RENDER_COMMAND>();
+    else if( aArgs[0] != wxS( "export" ) || aArgs.size() < 2 )
+        return nullptr;
+
+    aConsumed = 2;
+
+    const wxString& format = aArgs[1];
+
+    if( format == wxS( "drill" ) )
+        return std::make_unique<CLI::PCB_EXPORT_DRILL_COMMAND>();
+    else if( format == wxS( "dxf" ) )
+        return std::make_unique<CLI::PCB_EXPORT_DXF_COMMAND>();
+    else if( format == wxS( "gerber" ) )
+        return std::make_unique<CLI::PCB_EXPORT_GERBER_COMMAND>();
+    else if( format == wxS( "gerbers" ) )
+        return std::make_unique<CLI::PCB_EXPORT_GERBERS_COMMAND>();
+    else if( format == wxS( "ipc2581" ) )
+        return std::make_unique<CLI::PCB_EXPORT_IPC2581_COMMAND>();
+    else if( format == wxS( "pdf" ) )
+        return std::make_unique<CLI::PCB_EXPORT_PDF_COMMAND>();
+    else if( format == wxS( "pos" ) )
+        return std::make_unique<CLI::PCB_EXPORT_POS_COMMAND>();
+    else if( format == wxS( "svg" ) )
+        return std::make_unique<CLI::PCB_EXPORT_SVG_COMMAND>();
+
+    static const std::map<wxString, JOB_EXPORT_PCB_3D::FORMAT> formats3D = {
+        { wxS( "brep" ), JOB_EXPORT_PCB_3D::FORMAT::BREP },
+        { wxS( "glb" ),  JOB_EXPORT_PCB_3D::FORMAT::GLB },
+        { wxS( "step" ), JOB_EXPORT_PCB_3D::FORMAT::STEP },
+        { wxS( "vrml" ), JOB_EXPORT_PCB_3D::FORMAT::VRML },
+        { wxS( "xao" ),  JOB_EXPORT_PCB_3D::FORMAT::XAO }
+    };
+
+    if( formats3D.count( format ) )
+    {
+        return std::make_unique<CLI::PCB_EXPORT_3D_COMMAND>( format.ToStdString(), std::string(),
+                                                             formats3D.at( format ) );
+    }
+
+    return nullptr;
+}
+
+
+int CLI::PCB_BATCH_COMMAND::doPerform( KIWAY& aKiway )
+{
+    wxString jobsFile = From_UTF8( m_argParser.get<std::string>( ARG_JOBS ).c_str() );
+
+    if( !wxFile::Exists( m_argInput ) )
+    {
+        wxFprintf( stderr, _( "Board file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    wxTextFile file;
+
+    if( jobsFile.IsEmpty() || !wxFile::Exists( jobsFile ) || !file.Open( jobsFile ) )
+    {
+        wxFprintf( stderr, _( "Jobs file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    std::vector<std::pair<wxString, std::unique_ptr<COMMAND>>> commands;
+
+    // Parse the whole list first, so a typo at the end doesn't leave a half-generated output
+    for( size_t ii = 0; ii < file.GetLineCount(); ++ii )
+    {
+        wxString line = file[ii].Strip( wxString::both );
+
+        if( line.IsEmpty() || line.StartsWith( wxS( "#" ) ) )
+            continue;
+
+        wxArrayString args = wxCmdLineParser::ConvertStringToArgs( line, wxCMD_LINE_SPLIT_UNIX );
+        size_t        consumed = 0;
+
+        std::unique_ptr<COMMAND> command = createCommand( args, consumed );
+
+        if( !command )
+        {
+            wxFprintf( stderr, _( "Unknown command on line %d: %s\n" ), (int) ii + 1, line );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        std::vector<std::string> argv = { command->GetName() };
+
+        for( size_t jj = consumed; jj < args.size(); ++jj )
+            argv.emplace_back( args[jj].utf8_str() );
+
+        argv.emplace_back( m_argInput.utf8_str() );
+
+        try
+        {
+            // Use the C locale to parse arguments, as for the main command line
+            LOCALE_IO dummy;
+            command->GetArgParser().parse_args( argv );
+        }
+        catch( const std::exception& err )
+        {
+            wxFprintf( stderr, _( "Invalid command on line %d: %s\n" ), (int) ii + 1, line );
+            wxPrintf( "%s\n", err.what() );
+            command->PrintHelp();
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        commands.emplace_back( line, std::move( command ) );
+    }
+
+    int exitCode = EXIT_CODES::OK;
+
+    for( auto& [line, command] : commands )
+    {
+        wxPrintf( _( "Running '%s'\n" ), line );
+
+        int result = command->Perform( aKiway );
+
+        // Keep going, but report the first failure
+        if( result != EXIT_CODES::OK && result != EXIT_CODES::AVOID_CLOSING
+                && exitCode == EXIT_CODES::OK )
+        {
+            exitCode = result;
+        }
+    }
+
+    return exitCode;
+}
@@ -28,6 +28,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <future>
 #include <initializer_list>
 
@@ -190,23 +191,42 @@ void CONNECTIVITY_DATA::updateRatsnest()
                 return aNet->IsDirty() && aNet->GetNodeCount() > 0;
             } );
 
-    thread_pool& tp = GetKiCadThreadPool();
-
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
+    // A handful of large nets (power, ground) usually dominate the work.  Start them first and
+    // let every worker pull the next net as soon as it's done with the previous one, so the
+    // many small nets fill in around the large ones instead of being split in fixed chunks.
+    std::sort( dirty_nets.begin(), dirty_nets.end(),
+               []( const RN_NET* a, const RN_NET* b )
+               {
+                   return a->GetNodeCount() > b->GetNodeCount();
+               } );
+
+    thread_pool&        tp = GetKiCadThreadPool();
+    std::atomic<size_t> nextNet( 0 );
+    size_t              workers = std::min<size_t>( tp.get_thread_count(), dirty_nets.size() );
+
+    auto update_lambda =
+            [&]() -> size_t
             {
-                for( int ii = a; ii < b; ++ii )
-                    dirty_nets[ii]->UpdateNet();
-            } );
-    tp.wait_for_tasks();
+                size_t count = 0;
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
-            {
-                for( int ii = a; ii < b; ++ii )
+                for( size_t ii = nextNet++; ii < dirty_nets.size(); ii = nextNet++ )
+                {
+                    dirty_nets[ii]->UpdateNet();
                     dirty_nets[ii]->OptimizeRNEdges();
-            } );
-    tp.wait_for_tasks();
+                    count++;
+                }
+
+                return count;
+            };
+
+    std::vector<std::future<size_t>> returns;
+    returns.reserve( workers );
+
+    for( size_t ii = 0; ii < workers; ++ii )
+        returns.emplace_back( tp.submit( update_lambda ) );
+
+    for( const std::future<size_t>& ret : returns )
+        ret.wait();
 
 #ifdef PROFILE
     rnUpdate.Show();
@@ -50,6 +50,7 @@
 #include <wildcards_and_files_ext.h>
 #include <reporter.h>
 #include <gbr_metadata.h>
+#include <core/thread_pool.h>
 
 
 // Oblong holes can be drilled by a "canned slot" command (G85) or a routing command
@@ -86,64 +87,91 @@ bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     if( !m_merge_PTH_NPTH )
         hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    if( aGenDrill )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file to be
-        // sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole
-        // drill file is created (do not create any PTH drill file can be seen as not working
-        // drill generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-        {
-            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
-            fn.SetPath( aPlotDirectory );
-
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
+        // Each file is built and written by its own copy of this writer, on the thread pool.
+        // The copies share the board, which is only read.
+        auto createFile =
+                [this]( DRILL_LAYER_PAIR aPair, bool aDoingNpth,
+                        const wxString& aFullFilename ) -> DRILL_FILE_STATUS
+                {
+                    EXCELLON_WRITER writer( *this );
 
-                FILE* file = wxFopen( fullFilename, wxT( "w" ) );
+                    writer.buildHolesList( aPair, aDoingNpth );
 
-                if( file == nullptr )
-                {
-                    if( aReporter )
+                    // The file is created if it has holes, or if it is the non plated drill file
+                    // to be sure the NPTH file is up to date in separate files mode.
+                    // Also a PTH drill/map file is always created, to be sure at least one
+                    // plated hole drill file is created (do not create any PTH drill file can be
+                    // seen as not working drill generator).
+                    if( writer.getHolesCount() == 0 && !aDoingNpth
+                            && aPair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
                     {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
+                        return DRILL_FILE_STATUS::NOT_NEEDED;
                     }
 
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
+                    FILE* file = wxFopen( aFullFilename, wxT( "w" ) );
+
+                    if( file == nullptr )
+                        return DRILL_FILE_STATUS::FAILED;
+
+                    TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
+
+                    // Only external layer pair can have non plated hole
+                    // internal layers have only plated via holes
+                    if( aPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
                     {
-                        msg.Printf( _( "Created file '%s'" ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
+                        if( writer.m_merge_PTH_NPTH )
+                            file_type = TYPE_FILE::MIXED_FILE;
+                        else if( aDoingNpth )
+                            file_type = TYPE_FILE::NPTH_FILE;
                     }
-                }
 
-                TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
+                    writer.createDrillFile( file, aPair, file_type );
+                    return DRILL_FILE_STATUS::CREATED;
+                };
+
+        // The numeric locale is process-wide: keep it set for the whole time the files are
+        // written
+        LOCALE_IO dummy;
+
+        thread_pool&                                tp = GetKiCadThreadPool();
+        std::vector<wxString>                       filenames;
+        std::vector<std::future<DRILL_FILE_STATUS>> returns;
 
-                // Only external layer pair can have non plated hole
-                // internal layers have only plated via holes
-                if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+        for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
+             it != hole_sets.end();  ++it )
+        {
+            DRILL_LAYER_PAIR  pair = *it;
+            // For separate drill files, the last layer pair is the NPTH drill file.
+            bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
+
+            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
+            fn.SetPath( aPlotDirectory );
+
+            filenames.push_back( fn.GetFullPath() );
+            returns.push_back( tp.submit( createFile, pair, doing_npth, filenames.back() ) );
+        }
+
+        // Report in layer pair order, whatever order the files are finished in
+        for( size_t ii = 0; ii < returns.size(); ++ii )
+        {
+            DRILL_FILE_STATUS status = returns[ii].get();
+
+            if( status == DRILL_FILE_STATUS::FAILED )
+            {
+                success = false;
+
+                if( aReporter )
                 {
-                    if( m_merge_PTH_NPTH )
-                        file_type = TYPE_FILE::MIXED_FILE;
-                    else if( doing_npth )
-                        file_type = TYPE_FILE::NPTH_FILE;
+                    msg.Printf( _( "Failed to create file '%s'." ), filenames[ii] );
+                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
                 }
-
-                createDrillFile( file, pair, file_type );
+            }
+            else if( status == DRILL_FILE_STATUS::CREATED && aReporter )
+            {
+                msg.Printf( _( "Created file '%s'" ), filenames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ACTION );
             }
         }
     }
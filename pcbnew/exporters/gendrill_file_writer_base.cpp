@@ -29,18 +29,22 @@
 #include <pcb_track.h>
 #include <collectors.h>
 #include <reporter.h>
+#include <math/util.h>      // for KiROUND
 
 #include <gendrill_file_writer_base.h>
 
+#include <algorithm>
+
 
 /* Helper function for sorting hole list.
  * Compare function used for sorting holes type type:
  * plated then not plated
  * then by increasing diameter value
  * then by attribute type (vias, pad, mechanical)
- * then by X then Y position
+ * then by position along the drilling path (see sortHoles())
  */
-static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
+static bool cmpHoleSorting( const HOLE_INFO& a, uint64_t aPathIdx, const HOLE_INFO& b,
+                            uint64_t bPathIdx )
 {
     if( a.m_Hole_NotPlated != b.m_Hole_NotPlated )
         return b.m_Hole_NotPlated;
@@ -53,9 +57,13 @@ static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
     if( a.m_HoleAttribute != b.m_HoleAttribute )
         return a.m_HoleAttribute < b.m_HoleAttribute;
 
-    // At this point (same diameter, same type), sort by X then Y position.
-    // This is optimal for drilling and make the file reproducible as long as holes
-    // have not changed, even if the data order has changed.
+    // At this point (same diameter, same type), follow the drilling path
+    if( aPathIdx != bPathIdx )
+        return aPathIdx < bPathIdx;
+
+    // Holes in the same path cell are sorted by X then Y position.
+    // This makes the file reproducible as long as holes have not changed, even if the data
+    // order has changed.
     if( a.m_Hole_Pos.x != b.m_Hole_Pos.x )
         return a.m_Hole_Pos.x < b.m_Hole_Pos.x;
 
@@ -63,6 +71,79 @@ static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
 }
 
 
+uint64_t GENDRILL_WRITER_BASE::HilbertIndex( uint32_t aX, uint32_t aY )
+{
+    const uint32_t n = 1 << 16;
+    uint64_t       index = 0;
+
+    for( uint32_t s = n / 2; s > 0; s /= 2 )
+    {
+        uint32_t rx = ( aX & s ) ? 1 : 0;
+        uint32_t ry = ( aY & s ) ? 1 : 0;
+
+        index += (uint64_t) s * s * ( ( 3 * rx ) ^ ry );
+
+        // Rotate the quadrant, to keep the curve continuous
+        if( ry == 0 )
+        {
+            if( rx == 1 )
+            {
+                aX = n - 1 - aX;
+                aY = n - 1 - aY;
+            }
+
+            std::swap( aX, aY );
+        }
+    }
+
+    return index;
+}
+
+
+/* Sort the hole list by tool, and for each tool along a Hilbert curve laid on a grid covering
+ * the holes (see cmpHoleSorting()).
+ */
+static void sortHoles( std::vector<HOLE_INFO>& aHoles )
+{
+    if( aHoles.empty() )
+        return;
+
+    BOX2I bbox( aHoles[0].m_Hole_Pos, VECTOR2I( 0, 0 ) );
+
+    for( const HOLE_INFO& hole : aHoles )
+        bbox.Merge( hole.m_Hole_Pos );
+
+    double cellScale = 65535.0 / std::max<double>( 1.0, std::max( bbox.GetWidth(),
+                                                                  bbox.GetHeight() ) );
+
+    std::vector<std::pair<uint64_t, size_t>> order;
+    order.reserve( aHoles.size() );
+
+    for( size_t ii = 0; ii < aHoles.size(); ii++ )
+    {
+        VECTOR2I cell = aHoles[ii].m_Hole_Pos - bbox.GetOrigin();
+
+        order.emplace_back( GENDRILL_WRITER_BASE::HilbertIndex( KiROUND( cell.x * cellScale ),
+                                                                KiROUND( cell.y * cellScale ) ),
+                            ii );
+    }
+
+    std::sort( order.begin(), order.end(),
+               [&]( const std::pair<uint64_t, size_t>& a, const std::pair<uint64_t, size_t>& b )
+               {
+                   return cmpHoleSorting( aHoles[a.second], a.first, aHoles[b.second], b.first );
+               } );
+
+    std::vector<HOLE_INFO> sorted;
+    sorted.reserve( aHoles.size() );
+
+    for( const std::pair<uint64_t, size_t>& entry : order )
+        sorted.push_back( aHoles[entry.second] );
+
+    aHoles = std::move( sorted );
+}
+
+
 void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
                                            bool aGenerateNPTH_list )
 {
@@ -162,8 +243,8 @@ void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
         }
     }
 
-    // Sort holes per increasing diameter value (and for each dimater, by position)
-    sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), cmpHoleSorting );
+    // Sort holes per increasing diameter value (and for each diameter, along the drilling path)
+    sortHoles( m_holeListBuffer );
 
     // build the tool list
     int last_hole = -1;     // Set to not initialized (this is a value not used
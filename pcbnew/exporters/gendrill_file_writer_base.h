@@ -35,6 +35,7 @@
 // Set to 1 to add these comments and 0 to not use these comments
 #define USE_ATTRIB_FOR_HOLES 1
 
+#include <cstdint>
 #include <vector>
 
 class BOARD_ITEM;
@@ -214,6 +215,15 @@ public:
      */
     bool CreateMapFilesSet( const wxString& aPlotDirectory, REPORTER* aReporter = nullptr );
 
+    /**
+     * Return the index of the cell (\a aX, \a aY) of a 2^16 x 2^16 grid along the Hilbert
+     * curve which covers the grid.
+     *
+     * Consecutive cells on the curve are adjacent on the grid, so holes sorted this way are
+     * drilled without the long moves of a row by row (or column by column) scan.
+     */
+    static uint64_t HilbertIndex( uint32_t aX, uint32_t aY );
+
     /**
      * Create a plain text report file giving a list of drill values and drill count for through
      * holes, oblong holes, and for buried vias, drill values and drill count per layer pair
@@ -364,6 +374,14 @@ protected:
 
 
 protected:
+    /// The result of the creation of one drill file, when the files are created concurrently
+    enum class DRILL_FILE_STATUS
+    {
+        NOT_NEEDED,     ///< no hole, and the file is not mandatory
+        CREATED,
+        FAILED
+    };
+
     // Use derived classes to build a fully initialized GENDRILL_WRITER_BASE class.
     GENDRILL_WRITER_BASE( BOARD* aPcb )
     {
@@ -38,6 +38,7 @@
 #include <gendrill_gerber_writer.h>
 #include <reporter.h>
 #include <gbr_metadata.h>
+#include <core/thread_pool.h>
 
 // set to 1 to use flashed oblong holes, 0 to draw them by a line (route holes).
 // WARNING: currently ( gerber-layer-format-specification-revision-2023-08 ),
@@ -73,51 +74,76 @@ bool GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory, b
     // (Gerber drill files are separate files for PTH and NPTH)
     hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    if( aGenDrill )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole drill
-        // file is created (do not create any PTH drill file can be seen as not working drill
-        // generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+        // Each file is built and plotted by its own copy of this writer, on the thread pool.
+        // The copies share the board, which is only read.
+        auto createFile =
+                [this]( DRILL_LAYER_PAIR aPair, bool aDoingNpth,
+                        wxString aFullFilename ) -> DRILL_FILE_STATUS
+                {
+                    GERBER_WRITER writer( *this );
+
+                    writer.buildHolesList( aPair, aDoingNpth );
+
+                    // The file is created if it has holes, or if it is the non plated drill file
+                    // to be sure the NPTH file is up to date in separate files mode.
+                    // Also a PTH drill/map file is always created, to be sure at least one
+                    // plated hole drill file is created (do not create any PTH drill file can be
+                    // seen as not working drill generator).
+                    if( writer.getHolesCount() == 0 && !aDoingNpth
+                            && aPair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                    {
+                        return DRILL_FILE_STATUS::NOT_NEEDED;
+                    }
+
+                    if( writer.createDrillFile( aFullFilename, aDoingNpth, aPair ) < 0 )
+                        return DRILL_FILE_STATUS::FAILED;
+
+                    return DRILL_FILE_STATUS::CREATED;
+                };
+
+        // The numeric locale is process-wide: keep it set for the whole time the files are
+        // plotted
+        LOCALE_IO dummy;
+
+        thread_pool&                                tp = GetKiCadThreadPool();
+        std::vector<wxString>                       filenames;
+        std::vector<std::future<DRILL_FILE_STATUS>> returns;
+
+        for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
+             it != hole_sets.end();  ++it )
         {
+            DRILL_LAYER_PAIR  pair = *it;
+            // For separate drill files, the last layer pair is the NPTH drill file.
+            bool doing_npth = ( it == hole_sets.end() - 1 );
+
             fn = getDrillFileName( pair, doing_npth, false );
             fn.SetPath( aPlotDirectory );
 
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
+            filenames.push_back( fn.GetFullPath() );
+            returns.push_back( tp.submit( createFile, pair, doing_npth, filenames.back() ) );
+        }
 
-                int result = createDrillFile( fullFilename, doing_npth, pair );
+        // Report in layer pair order, whatever order the files are finished in
+        for( size_t ii = 0; ii < returns.size(); ++ii )
+        {
+            DRILL_FILE_STATUS status = returns[ii].get();
 
-                if( result < 0 )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
-                    }
+            if( status == DRILL_FILE_STATUS::FAILED )
+            {
+                success = false;
 
-                    break;
-                }
-                else
+                if( aReporter )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Created file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
-                    }
+                    msg.Printf( _( "Failed to create file '%s'." ), filenames[ii] );
+                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
                 }
-
+            }
+            else if( status == DRILL_FILE_STATUS::CREATED && aReporter )
+            {
+                msg.Printf( _( "Created file '%s'." ), filenames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ACTION );
             }
         }
     }
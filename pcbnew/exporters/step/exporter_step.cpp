@@ -52,6 +52,9 @@
 #include <wx/crt.h>
 #include <wx/log.h>
 #include <core/profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <core/thread_pool.h>
+
+#include <future>
 
 #define OCC_VERSION_MIN 0x070500
 
@@ -155,7 +158,8 @@ EXPORTER_STEP::~EXPORTER_STEP()
 }
 
 
-bool EXPORTER_STEP::buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOrigin )
+bool EXPORTER_STEP::buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOrigin,
+                                            std::vector<MODEL_PLACEMENT>& aModels )
 {
     bool              hasdata = false;
     std::vector<PAD*> padsMatchingNetFilter;
@@ -347,33 +351,16 @@ bool EXPORTER_STEP::buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOri
             continue;
         }
 
-        std::string fname( mname.ToUTF8() );
-        std::string refName( aFootprint->GetReference().ToUTF8() );
-        try
-        {
-            bool bottomSide = aFootprint->GetLayer() == B_Cu;
-
-            // the rotation is stored in degrees but opencascade wants radians
-            VECTOR3D modelRot = fp_model.m_Rotation;
-            modelRot *= M_PI;
-            modelRot /= 180.0;
-
-            if( m_pcbModel->AddComponent( fname, refName, bottomSide,
-                                          newpos,
-                                          aFootprint->GetOrientation().AsRadians(),
-                                          fp_model.m_Offset, modelRot,
-                                          fp_model.m_Scale, m_params.m_SubstModels ) )
-            {
-                hasdata = true;
-            }
-        }
-        catch( const Standard_Failure& e )
-        {
-            ReportMessage( wxString::Format( wxT( "Could not add 3D model to %s.\n"
-                                                  "OpenCASCADE error: %s\n" ),
-                                             aFootprint->GetReference(), e.GetMessageString() ) );
-        }
+        // the rotation is stored in degrees but opencascade wants radians
+        VECTOR3D modelRot = fp_model.m_Rotation;
+        modelRot *= M_PI;
+        modelRot /= 180.0;
 
+        // The model is added once all the model files of the board have been read
+        aModels.push_back( { std::string( mname.ToUTF8() ), aFootprint->GetReference(),
+                             aFootprint->GetLayer() == B_Cu, newpos,
+                             aFootprint->GetOrientation().AsRadians(), fp_model.m_Offset,
+                             modelRot, fp_model.m_Scale } );
     }
 
     return hasdata;
@@ -591,10 +578,37 @@ bool EXPORTER_STEP::buildBoard3DShapes()
 
     m_pcbModel->SetMaxError( m_board->GetDesignSettings().m_MaxError );
 
+    std::vector<MODEL_PLACEMENT> models;
+
     // For copper layers, only pads and tracks are added, because adding everything on copper
     // generate unreasonable file sizes and take a unreasonable calculation time.
     for( FOOTPRINT* fp : m_board->Footprints() )
-        buildFootprint3DShapes( fp, origin );
+        buildFootprint3DShapes( fp, origin, models );
+
+    // Read the distinct model files concurrently, then place them in the assembly
+    std::vector<std::string> modelFiles;
+
+    for( const MODEL_PLACEMENT& model : models )
+        modelFiles.push_back( model.m_fileName );
+
+    m_pcbModel->PreloadModels( modelFiles, m_params.m_SubstModels );
+
+    for( const MODEL_PLACEMENT& model : models )
+    {
+        try
+        {
+            m_pcbModel->AddComponent( model.m_fileName, std::string( model.m_reference.ToUTF8() ),
+                                      model.m_bottomSide, model.m_position, model.m_rotation,
+                                      model.m_offset, model.m_orientation, model.m_scale,
+                                      m_params.m_SubstModels );
+        }
+        catch( const Standard_Failure& e )
+        {
+            ReportMessage( wxString::Format( wxT( "Could not add 3D model to %s.\n"
+                                                  "OpenCASCADE error: %s\n" ),
+                                             model.m_reference, e.GetMessageString() ) );
+        }
+    }
 
     if( m_params.m_ExportTracksVias )
     {
@@ -613,37 +627,60 @@ bool EXPORTER_STEP::buildBoard3DShapes()
     SHAPE_POLY_SET pcbOutlinesNoArcs = pcbOutlines;
     pcbOutlinesNoArcs.ClearArcs();
 
-    for( PCB_LAYER_ID pcblayer : m_layersToExport.Seq() )
+    // The solids of each layer are built concurrently, and added to the model in layer order
+    thread_pool&                                        tp = GetKiCadThreadPool();
+    LSEQ                                                layers = m_layersToExport.Seq();
+    std::vector<std::future<std::vector<TopoDS_Shape>>> layerShapes;
+
+    for( PCB_LAYER_ID pcblayer : layers )
     {
-        SHAPE_POLY_SET poly = m_poly_shapes[pcblayer];
-        poly.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+        layerShapes.push_back( tp.submit(
+                [this, pcblayer, pcbOutlinesNoArcs, origin]( SHAPE_POLY_SET poly,
+                                                             SHAPE_POLY_SET holes )
+                {
+                    poly.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-        poly.SimplifyOutlines( pcbIUScale.mmToIU( 0.003 ) );
-        poly.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                    poly.SimplifyOutlines( pcbIUScale.mmToIU( 0.003 ) );
+                    poly.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-        SHAPE_POLY_SET holes = m_poly_holes[pcblayer];
-        holes.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                    holes.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-        // Mask layer is negative
-        if( pcblayer == F_Mask || pcblayer == B_Mask )
-        {
-            SHAPE_POLY_SET mask = pcbOutlinesNoArcs;
+                    // Mask layer is negative
+                    if( pcblayer == F_Mask || pcblayer == B_Mask )
+                    {
+                        SHAPE_POLY_SET mask = pcbOutlinesNoArcs;
 
-            mask.BooleanSubtract( poly, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-            mask.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                        mask.BooleanSubtract( poly, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                        mask.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-            poly = mask;
-        }
-        else
-        {
-            // Subtract holes
-            poly.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                        poly = mask;
+                    }
+                    else
+                    {
+                        // Subtract holes
+                        poly.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-            // Clip to board outline
-            poly.BooleanIntersection( pcbOutlinesNoArcs, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-        }
+                        // Clip to board outline
+                        poly.BooleanIntersection( pcbOutlinesNoArcs,
+                                                  SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                    }
 
-        m_pcbModel->AddPolygonShapes( &poly, pcblayer, origin );
+                    std::vector<TopoDS_Shape> shapes;
+                    m_pcbModel->MakeLayerShapes( shapes, &poly, pcblayer, origin );
+
+                    return shapes;
+                },
+                m_poly_shapes[pcblayer], m_poly_holes[pcblayer] ) );
+    }
+
+    // Let every task finish before a failed one can rethrow and unwind this frame
+    for( std::future<std::vector<TopoDS_Shape>>& shapes : layerShapes )
+        shapes.wait();
+
+    for( size_t ii = 0; ii < layers.size(); ++ii )
+    {
+        std::vector<TopoDS_Shape> shapes = layerShapes[ii].get();
+        m_pcbModel->AddLayerShapes( shapes, layers[ii] );
     }
 
     ReportMessage( wxT( "Create PCB solid model\n" ) );
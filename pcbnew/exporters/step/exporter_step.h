@@ -31,6 +31,7 @@
 #include <jobs/job_export_pcb_3d.h>     // For EXPORTER_STEP_PARAMS
 #include <layer_ids.h>
 #include <lset.h>
+#include <math/vector3.h>
 
 
 class PCBMODEL;
@@ -57,8 +58,22 @@ public:
     void SetWarn() { m_warn = true; }
 
 private:
+    /// A 3D model to add to the assembly, once the model files have been read
+    struct MODEL_PLACEMENT
+    {
+        std::string m_fileName;
+        wxString    m_reference;
+        bool        m_bottomSide;
+        VECTOR2D    m_position;
+        double      m_rotation;
+        VECTOR3D    m_offset;
+        VECTOR3D    m_orientation;
+        VECTOR3D    m_scale;
+    };
+
     bool buildBoard3DShapes();
-    bool buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOrigin );
+    bool buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOrigin,
+                                 std::vector<MODEL_PLACEMENT>& aModels );
     bool buildTrack3DShape( PCB_TRACK* aTrack, VECTOR2D aOrigin );
     void buildZones3DShape( VECTOR2D aOrigin );
     bool buildGraphic3DShape( BOARD_ITEM* aItem, VECTOR2D aOrigin );
@@ -25,9 +25,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <future>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <wx/dir.h>
 #include <wx/filename.h>
 #include <wx/filefn.h>
 #include <wx/stdpaths.h>
@@ -37,6 +41,11 @@
 
 #include <decompress.hpp>
 
+#include <advanced_config.h>
+#include <core/thread_pool.h>
+#include <mmh3_hash.h>
+#include <paths.h>
+
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
@@ -58,6 +67,7 @@
 #include <IGESData_IGESModel.hxx>
 #include <Interface_Static.hxx>
 #include <Quantity_Color.hxx>
+#include <STEPCAFControl_Controller.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <STEPCAFControl_Writer.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
@@ -74,6 +84,9 @@
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <XCAFApp_Application.hxx>
+#if OCC_VERSION_HEX >= 0x070500
+#include <BinXCAFDrivers.hxx>
+#endif
 #include <XCAFDoc.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 #include <XCAFDoc_ColorTool.hxx>
@@ -774,6 +787,12 @@ STEP_PCB_MODEL::STEP_PCB_MODEL( const wxString& aPcbName )
 
 STEP_PCB_MODEL::~STEP_PCB_MODEL()
 {
+    for( auto& [fileName, doc] : m_preloadedModels )
+    {
+        if( doc->CanClose() == CDM_CCS_OK )
+            doc->Close();
+    }
+
     if( m_doc->CanClose() == CDM_CCS_OK )
         m_doc->Close();
 }
@@ -1072,8 +1091,19 @@ void STEP_PCB_MODEL::getBoardBodyZPlacement( double& aZPos, double& aThickness )
 bool STEP_PCB_MODEL::AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
                                        const VECTOR2D& aOrigin )
 {
-    bool success = true;
+    std::vector<TopoDS_Shape> shapes;
+    bool                      success = MakeLayerShapes( shapes, aPolyShapes, aLayer, aOrigin );
+
+    AddLayerShapes( shapes, aLayer );
+
+    return success;
+}
+
 
+bool STEP_PCB_MODEL::MakeLayerShapes( std::vector<TopoDS_Shape>& aShapes,
+                                      const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
+                                      const VECTOR2D& aOrigin )
+{
     if( aPolyShapes->IsEmpty() )
         return true;
 
@@ -1083,21 +1113,27 @@ bool STEP_PCB_MODEL::AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LA
     double z_pos, thickness;
     getLayerZPlacement( aLayer, z_pos, thickness );
 
-    std::vector<TopoDS_Shape>& targetVec = IsCopperLayer( aLayer ) ? m_board_copper
-                                           : aLayer == F_SilkS || aLayer == B_SilkS
-                                                   ? m_board_silkscreen
-                                                   : m_board_soldermask;
-
-    if( !MakeShapes( targetVec, *aPolyShapes, m_simplifyShapes, thickness, z_pos, aOrigin ) )
+    if( !MakeShapes( aShapes, *aPolyShapes, m_simplifyShapes, thickness, z_pos, aOrigin ) )
     {
         ReportMessage(
                 wxString::Format( wxT( "Could not add shape (%d points) to copper layer on %s.\n" ),
                                   aPolyShapes->FullPointCount(), LayerName( aLayer ) ) );
 
-        success = false;
+        return false;
     }
 
-    return success;
+    return true;
+}
+
+
+void STEP_PCB_MODEL::AddLayerShapes( std::vector<TopoDS_Shape>& aShapes, PCB_LAYER_ID aLayer )
+{
+    std::vector<TopoDS_Shape>& targetVec = IsCopperLayer( aLayer ) ? m_board_copper
+                                           : aLayer == F_SilkS || aLayer == B_SilkS
+                                                   ? m_board_silkscreen
+                                                   : m_board_soldermask;
+
+    targetVec.insert( targetVec.end(), aShapes.begin(), aShapes.end() );
 }
 
 
@@ -2412,6 +2448,121 @@ bool STEP_PCB_MODEL::WriteXAO( const wxString& aFileName )
 }
 
 
+static bool setReaderPrecision()
+{
+    // The translation parameters are global, so they are set once here rather than by
+    // each reader when the models are read concurrently
+    STEPCAFControl_Controller::Init();
+    IGESControl_Controller::Init();
+
+    // Enable user-defined shape precision
+    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+        return false;
+
+    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
+    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+        return false;
+
+    return true;
+}
+
+
+/**
+ * @return the existing STEP or IGES files that can be used in place of a VRML model, in order
+ *         of preference.
+ */
+static std::vector<wxString> alternateModelFiles( const wxString& aFileName )
+{
+    // List of alternate files to look for
+    // Given in order of preference
+    static const wxChar* alts[] = {
+        // Step files
+        wxT( "stp" ), wxT( "step" ), wxT( "STP" ), wxT( "STEP" ), wxT( "Stp" ), wxT( "Step" ),
+        wxT( "stpz" ), wxT( "stpZ" ), wxT( "STPZ" ), wxT( "step.gz" ), wxT( "stp.gz" ),
+
+        // IGES files
+        wxT( "iges" ), wxT( "IGES" ), wxT( "igs" ), wxT( "IGS" )
+
+        //TODO - Other alternative formats?
+    };
+
+    wxFileName            wrlName( aFileName );
+    std::vector<wxString> files;
+
+    for( const wxChar* alt : alts )
+    {
+        wxFileName altFile( wrlName.GetPath(), wrlName.GetName() + wxT( "." ) + alt );
+
+        if( altFile.IsOk() && altFile.FileExists() )
+            files.push_back( altFile.GetFullPath() );
+    }
+
+    return files;
+}
+
+
+/**
+ * @return the directory holding the cached models.
+ */
+static wxString modelCacheDir()
+{
+    wxFileName cacheDir;
+
+    cacheDir.AssignDir( PATHS::GetUserCachePath() );
+    cacheDir.AppendDir( wxT( "step" ) );
+
+    return cacheDir.GetPath();
+}
+
+
+wxString STEP_PCB_MODEL::GetModelCacheFile( const wxString& aFileName )
+{
+    wxFileName fn( aFileName );
+    wxDateTime modTime;
+
+    if( !fn.GetTimes( nullptr, &modTime, nullptr ) )
+        return wxEmptyString;
+
+    // Any change of the model file or of the translation settings gives a new cache entry
+    wxString key = wxString::Format( wxT( "%s|%s|%lld|%g|%s" ), fn.GetFullPath(),
+                                     fn.GetSize().ToString(),
+                                     static_cast<long long>( modTime.GetValue().GetValue() ),
+                                     USER_PREC, OCC_VERSION_COMPLETE );
+
+    MMH3_HASH hash( 0x53544550 ); // Arbitrary seed
+    hash.add( std::string( key.ToUTF8() ) );
+
+    wxString cacheDir = modelCacheDir();
+
+    if( !PATHS::EnsurePathExists( cacheDir ) )
+        return wxEmptyString;
+
+    return wxFileName( cacheDir, hash.digest().ToString(), wxT( "xbf" ) ).GetFullPath();
+}
+
+
+/**
+ * Remove the cache files that have not been used for \a aNumDaysOld days.
+ */
+static void cleanModelCache( const wxString& aCacheDir, int aNumDaysOld )
+{
+    wxArrayString fileList;
+    wxDateTime    modTime;
+    wxDateTime    thresholdDate = wxDateTime::Now() - wxDateSpan::Days( aNumDaysOld );
+
+    wxDir::GetAllFiles( aCacheDir, &fileList, wxT( "*.xbf" ), wxDIR_FILES );
+
+    for( const wxString& file : fileList )
+    {
+        if( wxFileName( file ).GetTimes( nullptr, &modTime, nullptr )
+                && modTime.IsEarlierThan( thresholdDate ) )
+        {
+            wxRemoveFile( file );
+        }
+    }
+}
+
+
 bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D aScale, TDF_Label& aLabel,
                               bool aSubstituteModels, wxString* aErrorMessage )
 {
@@ -2429,7 +2580,18 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
     aLabel.Nullify();
 
     Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
+    auto                        preloaded = m_preloadedModels.find( aFileNameUTF8 );
+    bool                        isPreloaded = preloaded != m_preloadedModels.end();
+
+    if( isPreloaded )
+    {
+        doc = preloaded->second;
+        m_preloadedModels.erase( preloaded );
+    }
+    else
+    {
+        m_app->NewDocument( "MDTV-XCAF", doc );
+    }
 
     wxString fileName( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
     MODEL3D_FORMAT_TYPE modelFmt = fileType( aFileNameUTF8.c_str() );
@@ -2437,7 +2599,7 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
     switch( modelFmt )
     {
     case FMT_IGES:
-        if( !readIGES( doc, aFileNameUTF8.c_str() ) )
+        if( !isPreloaded && !readIGES( doc, aFileNameUTF8.c_str() ) )
         {
             ReportMessage( wxString::Format( wxT( "readIGES() failed on filename '%s'.\n" ),
                                              fileName ) );
@@ -2446,7 +2608,7 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
         break;
 
     case FMT_STEP:
-        if( !readSTEP( doc, aFileNameUTF8.c_str() ) )
+        if( !isPreloaded && !readSTEP( doc, aFileNameUTF8.c_str() ) )
         {
             ReportMessage( wxString::Format( wxT( "readSTEP() failed on filename '%s'.\n" ),
                                              fileName ) );
@@ -2542,55 +2704,22 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
         if( aSubstituteModels )
         {
             wxFileName wrlName( fileName );
+            wxString   baseName = wrlName.GetName();
 
-            wxString basePath = wrlName.GetPath();
-            wxString baseName = wrlName.GetName();
-
-            // List of alternate files to look for
-            // Given in order of preference
-            // (Break if match is found)
-            wxArrayString alts;
-
-            // Step files
-            alts.Add( wxT( "stp" ) );
-            alts.Add( wxT( "step" ) );
-            alts.Add( wxT( "STP" ) );
-            alts.Add( wxT( "STEP" ) );
-            alts.Add( wxT( "Stp" ) );
-            alts.Add( wxT( "Step" ) );
-            alts.Add( wxT( "stpz" ) );
-            alts.Add( wxT( "stpZ" ) );
-            alts.Add( wxT( "STPZ" ) );
-            alts.Add( wxT( "step.gz" ) );
-            alts.Add( wxT( "stp.gz" ) );
-
-            // IGES files
-            alts.Add( wxT( "iges" ) );
-            alts.Add( wxT( "IGES" ) );
-            alts.Add( wxT( "igs" ) );
-            alts.Add( wxT( "IGS" ) );
-
-            //TODO - Other alternative formats?
-
-            for( const auto& alt : alts )
+            for( const wxString& altFile : alternateModelFiles( fileName ) )
             {
-                wxFileName altFile( basePath, baseName + wxT( "." ) + alt );
-
-                if( altFile.IsOk() && altFile.FileExists() )
+                std::string altFileNameUTF8 = TO_UTF8( altFile );
+
+                // When substituting a STEP/IGS file for VRML, do not apply the VRML scaling
+                // to the new STEP model.  This process of auto-substitution is janky as all
+                // heck so let's not mix up un-displayed scale factors with potentially
+                // mis-matched files.  And hope that the user doesn't have multiples files
+                // named "model.wrl" and "model.stp" referring to different parts.
+                // TODO: Fix model handling in v7.  Default models should only be STP.
+                //       Have option to override this in DISPLAY.
+                if( getModelLabel( altFileNameUTF8, VECTOR3D( 1.0, 1.0, 1.0 ), aLabel, false ) )
                 {
-                    std::string altFileNameUTF8 = TO_UTF8( altFile.GetFullPath() );
-
-                    // When substituting a STEP/IGS file for VRML, do not apply the VRML scaling
-                    // to the new STEP model.  This process of auto-substitution is janky as all
-                    // heck so let's not mix up un-displayed scale factors with potentially
-                    // mis-matched files.  And hope that the user doesn't have multiples files
-                    // named "model.wrl" and "model.stp" referring to different parts.
-                    // TODO: Fix model handling in v7.  Default models should only be STP.
-                    //       Have option to override this in DISPLAY.
-                    if( getModelLabel( altFileNameUTF8, VECTOR3D( 1.0, 1.0, 1.0 ), aLabel, false ) )
-                    {
-                        return true;
-                    }
+                    return true;
                 }
             }
 
@@ -2634,6 +2763,10 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
 
     aLabel = transferModel( doc, m_doc, aScale );
 
+    // The model now lives in m_doc, so release the preloaded document
+    if( isPreloaded && doc->CanClose() == CDM_CCS_OK )
+        doc->Close();
+
     if( aLabel.IsNull() )
     {
         ReportMessage( wxString::Format( wxT( "Could not transfer model data from file '%s'.\n" ),
@@ -2654,6 +2787,162 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
 }
 
 
+void STEP_PCB_MODEL::PreloadModels( const std::vector<std::string>& aFileNamesUTF8,
+                                    bool aSubstituteModels )
+{
+    struct MODEL_READ
+    {
+        std::string                fileName;
+        MODEL3D_FORMAT_TYPE        format;
+        wxString                   cacheFile;
+        Handle( TDocStd_Document ) doc;
+    };
+
+    std::set<std::string>              requested( aFileNamesUTF8.begin(), aFileNamesUTF8.end() );
+    std::map<std::string, MODEL_READ>  reads;
+
+    // Resolve the files that getModelLabel() will actually read
+    for( const std::string& fileNameUTF8 : requested )
+    {
+        std::string         actual = fileNameUTF8;
+        MODEL3D_FORMAT_TYPE format = fileType( actual.c_str() );
+
+        if( ( format == FMT_WRL || format == FMT_WRZ ) && aSubstituteModels )
+        {
+            std::vector<wxString> alts =
+                    alternateModelFiles( wxString::FromUTF8( fileNameUTF8.c_str() ) );
+
+            if( alts.empty() )
+                continue;
+
+            actual = TO_UTF8( alts.front() );
+            format = fileType( actual.c_str() );
+        }
+
+        // Compressed STEP files are read through a temporary file by getModelLabel()
+        if( format != FMT_STEP && format != FMT_IGES )
+            continue;
+
+        if( !m_preloadedModels.count( actual ) )
+            reads[actual] = { actual, format, wxEmptyString, Handle( TDocStd_Document )() };
+    }
+
+    if( reads.empty() )
+        return;
+
+    ReportMessage( wxString::Format( wxT( "Reading %d 3D models.\n" ), (int) reads.size() ) );
+
+    bool useCache = !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache;
+
+#if OCC_VERSION_HEX >= 0x070500
+    static std::once_flag defineFormat;
+
+    std::call_once( defineFormat,
+                    [this]()
+                    {
+                        BinXCAFDrivers::DefineFormat( m_app );
+                    } );
+#else
+    useCache = false;
+#endif
+
+    std::vector<MODEL_READ*> toRead;
+
+    // Documents are created and opened here, only the translation runs in the worker threads
+    for( auto& [fileName, read] : reads )
+    {
+        if( useCache )
+            read.cacheFile = GetModelCacheFile( wxString::FromUTF8( fileName.c_str() ) );
+
+        if( !read.cacheFile.IsEmpty() && wxFileName::FileExists( read.cacheFile )
+            && m_app->Open( TCollection_ExtendedString( read.cacheFile.wc_str() ), read.doc )
+                       == PCDM_RS_OK )
+        {
+            // Keep the entry from being cleaned up as long as it is used
+            wxFileName( read.cacheFile ).Touch();
+            m_preloadedModels[fileName] = read.doc;
+            continue;
+        }
+
+        m_app->NewDocument( "MDTV-XCAF", read.doc );
+        toRead.push_back( &read );
+    }
+
+    // The entries used above have just been touched and the new ones aren't written yet
+    if( useCache && wxFileName::DirExists( modelCacheDir() ) )
+        cleanModelCache( modelCacheDir(), 30 );
+
+    if( toRead.empty() )
+        return;
+
+    if( !setReaderPrecision() )
+    {
+        // getModelLabel() reads the models itself and reports the error
+        for( MODEL_READ* read : toRead )
+        {
+            if( read->doc->CanClose() == CDM_CCS_OK )
+                read->doc->Close();
+        }
+
+        return;
+    }
+
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<bool>> results;
+
+    for( MODEL_READ* read : toRead )
+    {
+        results.push_back( tp.submit(
+                [this, read]() -> bool
+                {
+                    try
+                    {
+                        if( read->format == FMT_IGES )
+                            return readIGES( read->doc, read->fileName.c_str(), true );
+
+                        return readSTEP( read->doc, read->fileName.c_str(), true );
+                    }
+                    catch( const Standard_Failure& )
+                    {
+                        return false;
+                    }
+                } ) );
+    }
+
+    for( size_t ii = 0; ii < toRead.size(); ++ii )
+    {
+        MODEL_READ* read = toRead[ii];
+
+        if( !results[ii].get() )
+        {
+            // getModelLabel() reads the file again and reports the error
+            if( read->doc->CanClose() == CDM_CCS_OK )
+                read->doc->Close();
+
+            continue;
+        }
+
+        if( !read->cacheFile.IsEmpty() )
+        {
+            // Write to a temporary file first, other instances may be reading the cache
+            wxString tmpFile = wxFileName::CreateTempFileName( read->cacheFile );
+
+            read->doc->ChangeStorageFormat( "BinXCAF" );
+
+            if( !tmpFile.IsEmpty()
+                && ( m_app->SaveAs( read->doc, TCollection_ExtendedString( tmpFile.wc_str() ) )
+                             != PCDM_SS_OK
+                     || !wxRenameFile( tmpFile, read->cacheFile, true ) ) )
+            {
+                wxRemoveFile( tmpFile );
+            }
+        }
+
+        m_preloadedModels[read->fileName] = read->doc;
+    }
+}
+
+
 bool STEP_PCB_MODEL::getModelLocation( bool aBottom, VECTOR2D aPosition, double aRotation, VECTOR3D aOffset, VECTOR3D aOrientation,
                                  TopLoc_Location& aLocation )
 {
@@ -2726,23 +3015,18 @@ bool STEP_PCB_MODEL::getModelLocation( bool aBottom, VECTOR2D aPosition, double
 }
 
 
-bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
+bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname,
+                               bool aConcurrent )
 {
-    IGESControl_Controller::Init();
+    if( !aConcurrent && !setReaderPrecision() )
+        return false;
+
     IGESCAFControl_Reader reader;
     IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
 
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
-        return false;
-
     // set other translation options
     reader.SetColorMode( true );  // use model colors
     reader.SetNameMode( false );  // don't use IGES label names
@@ -2750,7 +3034,7 @@ bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fnam
 
     if( !reader.Transfer( doc ) )
     {
-        if( doc->CanClose() == CDM_CCS_OK )
+        if( !aConcurrent && doc->CanClose() == CDM_CCS_OK )
             doc->Close();
 
         return false;
@@ -2759,7 +3043,7 @@ bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fnam
     // are there any shapes to translate?
     if( reader.NbShapes() < 1 )
     {
-        if( doc->CanClose() == CDM_CCS_OK )
+        if( !aConcurrent && doc->CanClose() == CDM_CCS_OK )
             doc->Close();
 
         return false;
@@ -2769,22 +3053,18 @@ bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fnam
 }
 
 
-bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fname )
+bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fname,
+                               bool aConcurrent )
 {
+    if( !aConcurrent && !setReaderPrecision() )
+        return false;
+
     STEPCAFControl_Reader reader;
     IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
 
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
-        return false;
-
     // set other translation options
     reader.SetColorMode( true );  // use model colors
     reader.SetNameMode( true );  // use label names
@@ -2792,7 +3072,7 @@ bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fnam
 
     if( !reader.Transfer( doc ) )
     {
-        if( doc->CanClose() == CDM_CCS_OK )
+        if( !aConcurrent && doc->CanClose() == CDM_CCS_OK )
             doc->Close();
 
         return false;
@@ -2801,7 +3081,7 @@ bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fnam
     // are there any shapes to translate?
     if( reader.NbRootsForTransfer() < 1 )
     {
-        if( doc->CanClose() == CDM_CCS_OK )
+        if( !aConcurrent && doc->CanClose() == CDM_CCS_OK )
             doc->Close();
 
         return false;
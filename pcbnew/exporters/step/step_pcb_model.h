@@ -109,6 +109,34 @@ public:
     bool AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
                            const VECTOR2D& aOrigin );
 
+    // build the solids of a set of polygons without adding them to the model.  The model is
+    // not modified, so the shapes of several layers can be built concurrently
+    bool MakeLayerShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE_POLY_SET* aPolyShapes,
+                          PCB_LAYER_ID aLayer, const VECTOR2D& aOrigin );
+
+    // add the solids built by MakeLayerShapes() to the model
+    void AddLayerShapes( std::vector<TopoDS_Shape>& aShapes, PCB_LAYER_ID aLayer );
+
+    /**
+     * Read a list of model files ahead of the AddComponent() calls using them.
+     *
+     * STEP and IGES files, and the STEP/IGES substitutes of VRML files when \a aSubstituteModels
+     * is set, are read concurrently into their own documents.  Translated models are also kept
+     * in an on-disk cache, so exporting boards using the same models again skips the reading
+     * and translation of the model files.
+     *
+     * @param aFileNamesUTF8 is the list of model file names, duplicates are allowed.
+     * @param aSubstituteModels = true to read the substitutes of VRML models.
+     */
+    void PreloadModels( const std::vector<std::string>& aFileNamesUTF8, bool aSubstituteModels );
+
+    /**
+     * @return the name of the file caching the translated data of a model file, or an empty
+     *         string if the cache is not available.  The name changes with the model file and
+     *         with the translation settings.
+     */
+    static wxString GetModelCacheFile( const wxString& aFileName );
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes, bool aBottom,
                        VECTOR2D aPosition, double aRotation, VECTOR3D aOffset,
@@ -222,8 +250,12 @@ private:
     bool getModelLocation( bool aBottom, VECTOR2D aPosition, double aRotation, VECTOR3D aOffset,
                            VECTOR3D aOrientation, TopLoc_Location& aLocation );
 
-    bool readIGES( Handle( TDocStd_Document ) & aDoc, const char* aFname );
-    bool readSTEP( Handle( TDocStd_Document ) & aDoc, const char* aFname );
+    // aConcurrent = true when reading from a worker thread.  The reader precision must then be
+    // set beforehand, and the document is left open on failure for the caller to close it
+    bool readIGES( Handle( TDocStd_Document ) & aDoc, const char* aFname,
+                   bool aConcurrent = false );
+    bool readSTEP( Handle( TDocStd_Document ) & aDoc, const char* aFname,
+                   bool aConcurrent = false );
     bool readVRML( Handle( TDocStd_Document ) & aDoc, const char* aFname );
 
     TDF_Label transferModel( Handle( TDocStd_Document )& source, Handle( TDocStd_Document ) & dest,
@@ -238,6 +270,8 @@ private:
     bool                            m_fuseShapes;       // fuse geometry together
     std::vector<TDF_Label>          m_pcb_labels;       // labels for the PCB model (one by main outline)
     MODEL_MAP                       m_models;           // map of file names to model labels
+    std::map<std::string, Handle( TDocStd_Document )>
+                                    m_preloadedModels;  // documents read by PreloadModels()
     int                             m_components;       // number of successfully loaded components;
     double                          m_precision;        // model (length unit) numeric precision
     double                          m_angleprec;        // angle numeric precision
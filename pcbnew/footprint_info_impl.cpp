@@ -41,26 +41,32 @@
 #include <wx/wfstream.h>
 
 
+// First line of the cache files carrying per-library timestamps
+static const wxString CACHE_FILE_VERSION = wxS( "#fp-info-cache v2" );
+
+
 void FOOTPRINT_INFO_IMPL::load()
 {
     FP_LIB_TABLE* fptable = m_owner->GetTable();
 
     wxASSERT( fptable );
 
-    const FOOTPRINT* footprint = fptable->GetEnumeratedFootprint( m_nickname, m_fpname );
+    // Footprints which cannot be parsed throw here, and are reported by the list's CatchErrors().
+    // Only a few fields are copied, so the footprint is not kept in the library cache for it.
+    bool found = fptable->VisitEnumeratedFootprint( m_nickname, m_fpname,
+            [this]( const FOOTPRINT& aFootprint )
+            {
+                m_pad_count = aFootprint.GetPadCount( DO_NOT_INCLUDE_NPTH );
+                m_unique_pad_count = aFootprint.GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+                m_keywords = aFootprint.GetKeywords();
+                m_doc = aFootprint.GetLibDescription();
+            } );
 
-    if( footprint == nullptr ) // Should happen only with malformed/broken libraries
+    if( !found ) // Should happen only with broken libraries
     {
         m_pad_count = 0;
         m_unique_pad_count = 0;
     }
-    else
-    {
-        m_pad_count = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
-        m_unique_pad_count = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
-        m_keywords = footprint->GetKeywords();
-        m_doc = footprint->GetLibDescription();
-    }
 
     m_loaded = true;
 }
@@ -70,6 +76,7 @@ void FOOTPRINT_LIST_IMPL::Clear()
 {
     m_list.clear();
     m_list_timestamp = 0;
+    m_lib_timestamps.clear();
 }
 
 
@@ -107,11 +114,31 @@ bool FOOTPRINT_LIST_IMPL::CatchErrors( const std::function<void()>& aFunc )
 bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname,
                                               PROGRESS_REPORTER* aProgressReporter )
 {
-    long long int generatedTimestamp = 0;
+    long long int                 generatedTimestamp = 0;
+    std::map<wxString, long long> libTimestamps;
 
     if( !CatchErrors( [&]()
                  {
-                     generatedTimestamp = aTable->GenerateTimestamp( aNickname );
+                     if( aNickname )
+                     {
+                         generatedTimestamp = aTable->GenerateTimestamp( aNickname );
+                         libTimestamps[ *aNickname ] = generatedTimestamp;
+                     }
+                     else
+                     {
+                         // Same as aTable->GenerateTimestamp( nullptr ), but keeping the
+                         // individual library timestamps
+                         for( const wxString& nickname : aTable->GetLogicalLibs() )
+                         {
+                             if( !aTable->HasLibrary( nickname, true ) )
+                                 continue;
+
+                             long long libTimestamp = aTable->GenerateTimestamp( &nickname );
+
+                             libTimestamps[ nickname ] = libTimestamp;
+                             generatedTimestamp += libTimestamp;
+                         }
+                     }
                  } ) )
     {
         return false;
@@ -125,31 +152,53 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
 
     m_progress_reporter = aProgressReporter;
 
-    if( m_progress_reporter )
-    {
-        m_progress_reporter->SetMaxProgress( m_queue_in.size() );
-        m_progress_reporter->Report( _( "Fetching footprint libraries..." ) );
-    }
-
     m_cancelled = false;
     m_lib_table = aTable;
 
     // Clear data before reading files
     m_errors.clear();
-    m_list.clear();
     m_queue_in.clear();
     m_queue_out.clear();
 
     if( aNickname )
     {
+        m_list.clear();
         m_queue_in.push( *aNickname );
     }
     else
     {
-        for( const wxString& nickname : aTable->GetLogicalLibs() )
-            m_queue_in.push( nickname );
+        // Only re-read the libraries that changed since their footprints were listed (possibly
+        // in a previous session, through the cache file)
+        std::vector<std::unique_ptr<FOOTPRINT_INFO>> unchanged;
+
+        for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : m_list )
+        {
+            auto libIt = libTimestamps.find( fpinfo->GetLibNickname() );
+            auto oldIt = m_lib_timestamps.find( fpinfo->GetLibNickname() );
+
+            if( libIt != libTimestamps.end() && oldIt != m_lib_timestamps.end()
+                    && libIt->second == oldIt->second )
+            {
+                unchanged.push_back( std::move( fpinfo ) );
+            }
+        }
+
+        m_list = std::move( unchanged );
+
+        for( const auto& [ nickname, libTimestamp ] : libTimestamps )
+        {
+            auto oldIt = m_lib_timestamps.find( nickname );
+
+            if( oldIt == m_lib_timestamps.end() || oldIt->second != libTimestamp )
+                m_queue_in.push( nickname );
+        }
     }
 
+    if( m_progress_reporter )
+    {
+        m_progress_reporter->SetMaxProgress( m_queue_in.size() );
+        m_progress_reporter->Report( _( "Fetching footprint libraries..." ) );
+    }
 
     loadLibs();
 
@@ -169,9 +218,16 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
     }
 
     if( m_cancelled )
-        m_list_timestamp = 0;       // God knows what we got before we were canceled
+    {
+        // God knows what we got before we were canceled
+        m_list_timestamp = 0;
+        m_lib_timestamps.clear();
+    }
     else
+    {
         m_list_timestamp = generatedTimestamp;
+        m_lib_timestamps = std::move( libTimestamps );
+    }
 
     return m_errors.empty();
 }
@@ -324,7 +380,17 @@ void FOOTPRINT_LIST_IMPL::WriteCacheToFile( const wxString& aFilePath )
         return;
     }
 
+    // Older versions expect the list timestamp on the first line; they will fail to parse the
+    // version tag and simply re-read the libraries.
+    txtStream << CACHE_FILE_VERSION << endl;
     txtStream << wxString::Format( wxT( "%lld" ), m_list_timestamp ) << endl;
+    txtStream << wxString::Format( wxT( "%u" ), (unsigned) m_lib_timestamps.size() ) << endl;
+
+    for( const auto& [ nickname, libTimestamp ] : m_lib_timestamps )
+    {
+        txtStream << nickname << endl;
+        txtStream << wxString::Format( wxT( "%lld" ), libTimestamp ) << endl;
+    }
 
     for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : m_list )
     {
@@ -358,12 +424,33 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
 
     m_list_timestamp = 0;
     m_list.clear();
+    m_lib_timestamps.clear();
 
     try
     {
         if( cacheFile.Exists() && cacheFile.Open() )
         {
-            cacheFile.GetFirstLine().ToLongLong( &m_list_timestamp );
+            if( cacheFile.GetFirstLine() == CACHE_FILE_VERSION )
+            {
+                unsigned long libCount = 0;
+
+                cacheFile.GetNextLine().ToLongLong( &m_list_timestamp );
+                cacheFile.GetNextLine().ToULong( &libCount );
+
+                for( unsigned long ii = 0; ii < libCount; ++ii )
+                {
+                    wxString  nickname = cacheFile.GetNextLine();
+                    long long libTimestamp = 0;
+
+                    cacheFile.GetNextLine().ToLongLong( &libTimestamp );
+                    m_lib_timestamps[ nickname ] = libTimestamp;
+                }
+            }
+            else
+            {
+                // Old format: only the timestamp of the whole list
+                cacheFile.GetFirstLine().ToLongLong( &m_list_timestamp );
+            }
 
             while( cacheFile.GetCurrentLine() + 6 < cacheFile.GetLineCount() )
             {
@@ -387,11 +474,15 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
     {
         // whatever went wrong, invalidate the cache
         m_list_timestamp = 0;
+        m_lib_timestamps.clear();
     }
 
     // Sanity check: an empty list is very unlikely to be correct.
     if( m_list.size() == 0 )
+    {
         m_list_timestamp = 0;
+        m_lib_timestamps.clear();
+    }
 
     if( cacheFile.IsOpened() )
         cacheFile.Close();
@@ -361,6 +361,10 @@ bool FOOTPRINT_EDIT_FRAME::SaveLibraryAs( const wxString& aLibraryPath )
         for( unsigned i = 0;  i < footprints.size();  ++i )
         {
             const FOOTPRINT* footprint = cur->GetEnumeratedFootprint( curLibPath, footprints[i] );
+
+            if( !footprint )
+                continue;
+
             dst->FootprintSave( dstLibPath, footprint );
 
             msg = wxString::Format( _( "Footprint '%s' saved." ), footprints[i] );
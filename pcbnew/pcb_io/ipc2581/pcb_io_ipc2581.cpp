@@ -42,8 +42,10 @@
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
 
+#include <wx/filename.h>
 #include <wx/log.h>
 #include <wx/numformatter.h>
+#include <wx/wfstream.h>
 #include <wx/xml/xml.h>
 
 
@@ -123,19 +125,18 @@ void PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, wxXmlNode* aNode )
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
-
-    if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
+    if( m_last_appended_node && m_last_appended_node->GetParent() == aParent
+            && m_last_appended_node->GetNext() == nullptr )
     {
         aNode->SetParent( aParent );
-        lastNode->SetNext( aNode );
+        m_last_appended_node->SetNext( aNode );
     }
     else
     {
         aParent->AddChild( aNode );
     }
 
-    lastNode = aNode;
+    m_last_appended_node = aNode;
 
     // Opening tag, closing tag, brackets and the closing slash
     m_total_bytes += 2 * aNode->GetName().size() + 5;
@@ -151,6 +152,18 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
 }
 
 
+void PCB_IO_IPC2581::deleteNode( wxXmlNode* aNode )
+{
+    if( wxXmlNode* parent = aNode->GetParent() )
+        parent->RemoveChild( aNode );
+
+    delete aNode;
+
+    // The append cache may have pointed to the node or to any of its children
+    m_last_appended_node = nullptr;
+}
+
+
 wxString PCB_IO_IPC2581::genString( const wxString& aStr, const char* aPrefix ) const
 {
     wxString str;
@@ -732,8 +745,7 @@ void PCB_IO_IPC2581::addText( wxXmlNode* aContentNode, EDA_TEXT* aText,
 
     if( text_node->GetChildren() == nullptr )
     {
-        aContentNode->RemoveChild( text_node );
-        delete text_node;
+        deleteNode( text_node );
     }
 }
 
@@ -1884,8 +1896,7 @@ bool PCB_IO_IPC2581::addOutlineNode( wxXmlNode* aParentNode, const SHAPE_POLY_SE
 
     if( !outlineNode->GetChildren() )
     {
-        aParentNode->RemoveChild( outlineNode );
-        delete outlineNode;
+        deleteNode( outlineNode );
         return false;
     }
 
@@ -1912,8 +1923,7 @@ bool PCB_IO_IPC2581::addContourNode( wxXmlNode* aParentNode, const SHAPE_POLY_SE
     }
     else
     {
-        aParentNode->RemoveChild( contourNode );
-        delete contourNode;
+        deleteNode( contourNode );
         return false;
     }
 
@@ -1936,8 +1946,7 @@ void PCB_IO_IPC2581::generateProfile( wxXmlNode* aStepNode )
     if( !addPolygonNode( profileNode, board_outline.Polygon( 0 ) ) )
     {
         wxLogTrace( traceIpc2581, wxS( "Failed to add polygon to profile" ) );
-        aStepNode->RemoveChild( profileNode );
-        delete profileNode;
+        deleteNode( profileNode );
     }
 }
 
@@ -2166,10 +2175,7 @@ wxXmlNode* PCB_IO_IPC2581::addPackage( wxXmlNode* aContentNode, FOOTPRINT* aFp )
 
         if( group_node->GetChildren() == nullptr )
         {
-            marking_node->RemoveChild( group_node );
-            layer_node->RemoveChild( marking_node );
-            delete group_node;
-            delete marking_node;
+            deleteNode( marking_node );
         }
     }
 
@@ -2447,8 +2453,11 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
 
         if( layerNode->GetChildren() == nullptr )
         {
-            aStepNode->RemoveChild( layerNode );
-            delete layerNode;
+            deleteNode( layerNode );
+        }
+        else
+        {
+            spoolNode( layerNode );
         }
     }
 }
@@ -2517,6 +2526,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
                 addXY( holeNode, pad->GetPosition() );
             }
         }
+
+        spoolNode( layerNode );
     }
 
     hole_count = 1;
@@ -2535,6 +2546,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
 
             addSlotCavity( padNode, *pad, wxString::Format( "SLOT%d", hole_count++ ) );
         }
+
+        spoolNode( layerNode );
     }
 }
 
@@ -2806,20 +2819,17 @@ void PCB_IO_IPC2581::generateLayerSetNet( wxXmlNode* aLayerNode, PCB_LAYER_ID aL
 
     if( specialNode->GetChildren() == nullptr )
     {
-        featureSetNode->RemoveChild( specialNode );
-        delete specialNode;
+        deleteNode( specialNode );
     }
 
     if( featureSetNode->GetChildren() == nullptr )
     {
-        layerSetNode->RemoveChild( featureSetNode );
-        delete featureSetNode;
+        deleteNode( featureSetNode );
     }
 
     if( layerSetNode->GetChildren() == nullptr )
     {
-        aLayerNode->RemoveChild( layerSetNode );
-        delete layerSetNode;
+        deleteNode( layerSetNode );
     }
 }
 
@@ -2917,6 +2927,175 @@ wxXmlNode* PCB_IO_IPC2581::generateAvlSection()
 }
 
 
+static void writeUtf8( wxOutputStream& aStream, const wxString& aStr )
+{
+    const wxScopedCharBuffer utf8 = aStr.utf8_str();
+    aStream.Write( utf8.data(), utf8.length() );
+}
+
+
+static void writeEscaped( wxOutputStream& aStream, const wxString& aStr, bool aAttribute )
+{
+    const wxScopedCharBuffer utf8 = aStr.utf8_str();
+    std::string              escaped;
+
+    escaped.reserve( utf8.length() );
+
+    // The characters to escape are all ASCII, so they never appear inside a multibyte sequence
+    for( size_t ii = 0; ii < utf8.length(); ++ii )
+    {
+        char c = utf8.data()[ii];
+
+        switch( c )
+        {
+        case '&': escaped += "&amp;"; break;
+        case '<': escaped += "&lt;"; break;
+        case '>': escaped += "&gt;"; break;
+        case '"': escaped += aAttribute ? "&quot;" : "\""; break;
+        case '\t': escaped += aAttribute ? "&#x9;" : "\t"; break;
+        case '\n': escaped += aAttribute ? "&#xA;" : "\n"; break;
+        case '\r': escaped += "&#xD;"; break;
+        default: escaped += c; break;
+        }
+    }
+
+    aStream.Write( escaped.data(), escaped.size() );
+}
+
+
+static void writeIndent( wxOutputStream& aStream, int aIndent )
+{
+    static const char spaces[] = "                                ";
+
+    aStream.PutC( '\n' );
+
+    while( aIndent > 0 )
+    {
+        int count = std::min<int>( aIndent, sizeof( spaces ) - 1 );
+        aStream.Write( spaces, count );
+        aIndent -= count;
+    }
+}
+
+
+bool PCB_IO_IPC2581::writeNode( wxOutputStream& aStream, const wxXmlNode* aNode, int aIndent )
+{
+    if( auto it = m_spooled_nodes.find( aNode ); it != m_spooled_nodes.end() )
+    {
+        std::vector<char> buffer( 256 * 1024 );
+        wxFileOffset      remaining = it->second.second - it->second.first;
+
+        if( !m_spool.Seek( it->second.first ) )
+            return false;
+
+        while( remaining > 0 )
+        {
+            size_t count = std::min<wxFileOffset>( remaining, buffer.size() );
+
+            if( m_spool.Read( buffer.data(), count ) != count )
+                return false;
+
+            aStream.Write( buffer.data(), count );
+            remaining -= count;
+        }
+
+        return aStream.IsOk();
+    }
+
+    if( aNode->GetType() == wxXML_TEXT_NODE )
+    {
+        writeEscaped( aStream, aNode->GetContent(), false );
+        return aStream.IsOk();
+    }
+
+    if( aNode->GetType() != wxXML_ELEMENT_NODE )
+        return true;
+
+    aStream.PutC( '<' );
+    writeUtf8( aStream, aNode->GetName() );
+
+    for( const wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        aStream.PutC( ' ' );
+        writeUtf8( aStream, attr->GetName() );
+        aStream.Write( "=\"", 2 );
+        writeEscaped( aStream, attr->GetValue(), true );
+        aStream.PutC( '"' );
+    }
+
+    if( !aNode->GetChildren() )
+    {
+        aStream.Write( "/>", 2 );
+        return aStream.IsOk();
+    }
+
+    aStream.PutC( '>' );
+
+    // Same layout as wxXmlDocument::Save(): text stays inline, elements go on their own line
+    const wxXmlNode* last = nullptr;
+
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        if( child->GetType() != wxXML_TEXT_NODE )
+            writeIndent( aStream, aIndent + 2 );
+
+        if( !writeNode( aStream, child, aIndent + 2 ) )
+            return false;
+
+        last = child;
+    }
+
+    if( last->GetType() != wxXML_TEXT_NODE )
+        writeIndent( aStream, aIndent );
+
+    aStream.Write( "</", 2 );
+    writeUtf8( aStream, aNode->GetName() );
+    aStream.PutC( '>' );
+
+    return aStream.IsOk();
+}
+
+
+void PCB_IO_IPC2581::spoolNode( wxXmlNode* aNode )
+{
+    if( !m_spool.IsOpened() || !aNode->GetChildren() )
+        return;
+
+    int depth = 0;
+
+    for( wxXmlNode* parent = aNode->GetParent();
+         parent && parent->GetType() == wxXML_ELEMENT_NODE; parent = parent->GetParent() )
+    {
+        depth++;
+    }
+
+    wxFileOffset start = m_spool.Tell();
+    bool         ok;
+
+    {
+        wxFFileOutputStream    fileStream( m_spool );
+        wxBufferedOutputStream bufferedStream( fileStream, 256 * 1024 );
+
+        ok = writeNode( bufferedStream, aNode, 2 * depth );
+        bufferedStream.Sync();
+        ok = ok && fileStream.IsOk();
+    }
+
+    if( !ok )
+    {
+        // Keep the node in memory, it will be written with the rest of the document
+        wxLogTrace( traceIpc2581, wxS( "Failed to spool %s node" ), aNode->GetName() );
+        m_spool.Seek( start );
+        return;
+    }
+
+    while( aNode->GetChildren() )
+        deleteNode( aNode->GetChildren() );
+
+    m_spooled_nodes[aNode] = { start, m_spool.Tell() };
+}
+
+
 void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
                                 const std::map<std::string, UTF8>* aProperties )
 {
@@ -2973,6 +3152,34 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
             m_acceptable_chars.insert( c );
     }
 
+    // Finished layers are spooled to a temporary file so that the document held in memory
+    // stays limited to the dictionaries and the layer being generated
+    wxString spoolName = wxFileName::CreateTempFileName( wxS( "ipc2581" ) );
+
+    if( spoolName.IsEmpty() || !m_spool.Open( spoolName, wxS( "w+b" ) ) )
+        wxLogTrace( traceIpc2581, wxS( "Unable to create spool file, keeping data in memory" ) );
+
+    // Close and remove the spool file however we leave, including through an exception
+    struct SPOOL_REMOVER
+    {
+        ~SPOOL_REMOVER()
+        {
+            m_io->m_spooled_nodes.clear();
+
+            if( m_io->m_spool.IsOpened() )
+                m_io->m_spool.Close();
+
+            if( !m_spoolName.IsEmpty() )
+                wxRemoveFile( m_spoolName );
+        }
+
+        PCB_IO_IPC2581* m_io;
+        wxString        m_spoolName;
+    } spoolRemover{ this, spoolName };
+
+    m_spooled_nodes.clear();
+    m_last_appended_node = nullptr;
+
     m_xml_doc = new wxXmlDocument();
     m_xml_root = generateXmlHeader();
 
@@ -3024,11 +3231,32 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     out_stream.SetProgressCallback( update_progress );
 
-    if( !m_xml_doc->Save( out_stream ) )
+    bool ok = out_stream.IsOk();
+
+    if( ok )
     {
-        wxLogError( _( "Failed to save file to buffer" ) );
-        return;
+        static const char xmlDecl[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+        wxBufferedOutputStream buffered_stream( out_stream, 256 * 1024 );
+
+        buffered_stream.Write( xmlDecl, sizeof( xmlDecl ) - 1 );
+        ok = writeNode( buffered_stream, m_xml_root, 0 );
+        buffered_stream.PutC( '\n' );
+        buffered_stream.Sync();
+        ok = ok && out_stream.IsOk();
     }
 
-    size_t size = out_stream.GetSize();
+    delete m_xml_doc;
+    m_xml_doc = nullptr;
+    m_xml_root = nullptr;
+    m_last_appended_node = nullptr;
+    m_enterpriseNode = nullptr;
+    m_shape_user_node = nullptr;
+    m_shape_std_node = nullptr;
+    m_line_node = nullptr;
+    m_last_padstack = nullptr;
+    m_padstacks.clear();
+
+    if( !ok )
+        wxLogError( _( "Failed to save file to buffer" ) );
 }
@@ -30,8 +30,10 @@
 #include <geometry/shape_segment.h>
 #include <stroke_params.h>
 
+#include <wx/ffile.h>
 #include <wx/xml/xml.h>
 #include <memory>
+#include <unordered_map>
 
 class BOARD;
 class BOARD_ITEM;
@@ -46,6 +48,7 @@ class PCB_TEXT;
 class PROGRESS_REPORTER;
 class SHAPE_POLY_SET;
 class SHAPE_SEGMENT;
+class wxOutputStream;
 
 class PCB_IO_IPC2581 : public PCB_IO
 {
@@ -66,6 +69,7 @@ public:
         m_progress_reporter = nullptr;
         m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_last_appended_node = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -260,9 +264,33 @@ private:
 
     void insertNodeAfter( wxXmlNode* aPrev, wxXmlNode* aNode );
 
+    /**
+     * Detach \a aNode from its parent and free it with all its children.
+     *
+     * Every node freed during the export must go through here, so that appendNode() never
+     * links a new node to a deleted one.
+     */
+    void deleteNode( wxXmlNode* aNode );
+
     void addLayerAttributes( wxXmlNode* aNode, PCB_LAYER_ID aLayer );
 
     bool isValidLayerFor2581( PCB_LAYER_ID aLayer );
+
+    /**
+     * Write a finished node and its children to the spool file and free the children.
+     *
+     * The node is kept in the document as a placeholder for the spooled text, which is
+     * copied to the output when the file is saved.  Spooling each layer as soon as it is
+     * complete keeps the in-memory document to the dictionaries and the current layer.
+     */
+    void spoolNode( wxXmlNode* aNode );
+
+    /**
+     * Serialize \a aNode and its children to \a aStream at the given indentation, copying
+     * the content of spooled nodes from the spool file.
+     */
+    bool writeNode( wxOutputStream& aStream, const wxXmlNode* aNode, int aIndent );
+
 private:
 
     size_t                  m_total_bytes;  //<! Total number of bytes to be written
@@ -285,20 +313,20 @@ private:
     std::vector<FOOTPRINT*> m_loaded_footprints;
     const std::map<std::string, UTF8>*  m_props;
 
-    std::map<size_t, wxString> m_user_shape_dict;   //<! Map between shape hash values and reference id string
-    wxXmlNode*                 m_shape_user_node;   //<! Output XML node for reference shapes in UserDict
+    std::unordered_map<size_t, wxString> m_user_shape_dict;   //<! Map between shape hash values and reference id string
+    wxXmlNode*                           m_shape_user_node;   //<! Output XML node for reference shapes in UserDict
 
-    std::map<size_t, wxString> m_std_shape_dict;    //<! Map between shape hash values and reference id string
-    wxXmlNode*                 m_shape_std_node;    //<! Output XML node for reference shapes in StandardDict
+    std::unordered_map<size_t, wxString> m_std_shape_dict;    //<! Map between shape hash values and reference id string
+    wxXmlNode*                           m_shape_std_node;    //<! Output XML node for reference shapes in StandardDict
 
-    std::map<size_t, wxString> m_line_dict;         //<! Map between line hash values and reference id string
-    wxXmlNode*                 m_line_node;         //<! Output XML node for reference lines in LineDict
+    std::unordered_map<size_t, wxString> m_line_dict;         //<! Map between line hash values and reference id string
+    wxXmlNode*                           m_line_node;         //<! Output XML node for reference lines in LineDict
 
-    std::map<size_t, wxString> m_padstack_dict;     //<! Map between padstack hash values and reference id string (PADSTACK_##)
-    std::vector<wxXmlNode*>    m_padstacks;         //<! Holding vector for padstacks.  These need to be inserted prior to the components
-    wxXmlNode*                 m_last_padstack;     //<! Pointer to padstack list where we can insert the VIA padstacks once we process tracks
+    std::unordered_map<size_t, wxString> m_padstack_dict;     //<! Map between padstack hash values and reference id string (PADSTACK_##)
+    std::vector<wxXmlNode*>              m_padstacks;         //<! Holding vector for padstacks.  These need to be inserted prior to the components
+    wxXmlNode*                           m_last_padstack;     //<! Pointer to padstack list where we can insert the VIA padstacks once we process tracks
 
-    std::map<size_t, wxString>
+    std::unordered_map<size_t, wxString>
             m_footprint_dict; //<! Map between the footprint hash values and reference id string (<fpid>_##)
 
     std::map<wxString, FOOTPRINT*>
@@ -328,6 +356,12 @@ private:
 
     wxXmlDocument*          m_xml_doc;
     wxXmlNode*              m_xml_root;
+    wxXmlNode*              m_last_appended_node;  //<! Last node added by appendNode()
+
+    wxFFile                 m_spool;        //<! Temporary file holding the spooled nodes
+
+    std::unordered_map<const wxXmlNode*, std::pair<wxFileOffset, wxFileOffset>>
+            m_spooled_nodes; //<! Placeholder nodes and their start/end offsets in #m_spool
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
@@ -77,7 +77,8 @@ using namespace PCB_KEYS_T;
 
 FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_evictable( false )
 { }
 
 
@@ -107,18 +108,24 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
                                           m_lib_raw_path ) );
     }
 
+    // Footprints which were never parsed have to be read before the whole library is rewritten
+    if( !aFootprint )
+        loadAll();
+
     for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        if( aFootprint && aFootprint != it->second->GetFootprint() )
+        FOOTPRINT* footprint = it->second->m_footprint.get();
+
+        if( aFootprint && aFootprint != footprint )
             continue;
 
         // If we've requested to embed the fonts in the footprint, do so.
         // Otherwise, clear the embedded fonts from the footprint.  Embedded
         // fonts will be used if available
-        if( aFootprint->GetAreFontsEmbedded() )
-            aFootprint->EmbedFonts();
+        if( footprint->GetAreFontsEmbedded() )
+            footprint->EmbedFonts();
         else
-            aFootprint->GetEmbeddedFiles()->ClearEmbeddedFonts();
+            footprint->GetEmbeddedFiles()->ClearEmbeddedFonts();
 
         WX_FILENAME fn = it->second->GetFileName();
 
@@ -137,7 +144,7 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
             PRETTIFIED_FILE_OUTPUTFORMATTER formatter( tempFileName );
 
             m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( (BOARD_ITEM*) it->second->GetFootprint() );
+            m_owner->Format( footprint );
         }
 
 #ifdef USE_TMP_FILE
@@ -170,6 +177,35 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 
 
 void FP_CACHE::Load()
+{
+    Enumerate();
+
+    wxString cacheError;
+
+    // Queue I/O errors so only files that fail to parse don't get loaded.
+    for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); )
+    {
+        try
+        {
+            parseFootprint( *it->second );
+            ++it;
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            if( !cacheError.IsEmpty() )
+                cacheError += wxT( "\n\n" );
+
+            cacheError += ioe.What();
+            it = m_footprints.erase( it );
+        }
+    }
+
+    if( !cacheError.IsEmpty() )
+        THROW_IO_ERROR( cacheError );
+}
+
+
+void FP_CACHE::Enumerate()
 {
     m_cache_dirty = false;
     m_cache_timestamp = 0;
@@ -192,48 +228,165 @@ void FP_CACHE::Load()
 
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
-
         do
         {
             fn.SetFullName( fullName );
+            m_footprints.insert( fn.GetName(), new FP_CACHE_ITEM( nullptr, fn ) );
+        } while( dir.GetNext( &fullName ) );
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
-            {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_IO_KICAD_SEXPR_PARSER       parser( &reader, nullptr, nullptr );
+        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+    }
+}
 
-                FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
-                wxString fpName = fn.GetName();
 
-                if( !footprint )
-                    THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+const FOOTPRINT* FP_CACHE::GetFootprint( const wxString& aFootprintName, bool aPin )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
 
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
-            }
-            catch( const IO_ERROR& ioe )
-            {
-                if( !cacheError.IsEmpty() )
-                    cacheError += wxT( "\n\n" );
+    return findFootprint( aFootprintName, aPin );
+}
 
-                cacheError += wxString::Format( _( "Unable to read file '%s'" ) + '\n',
-                                                fn.GetFullPath() );
-                cacheError += ioe.What();
-            }
-        } while( dir.GetNext( &fullName ) );
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+bool FP_CACHE::VisitFootprint( const wxString& aFootprintName,
+                               const std::function<void( const FOOTPRINT& )>& aVisitor )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    const FOOTPRINT* footprint = findFootprint( aFootprintName, false );
+
+    if( !footprint )
+        return false;
+
+    aVisitor( *footprint );
+    return true;
+}
+
+
+wxString FP_CACHE::GetParseErrors()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_parseErrors;
+}
+
+
+const FOOTPRINT* FP_CACHE::findFootprint( const wxString& aFootprintName, bool aPin )
+{
+    FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.find( aFootprintName );
+
+    if( it == m_footprints.end() )
+        return nullptr;
+
+    FP_CACHE_ITEM& item = *it->second;
+
+    if( !item.m_footprint )
+    {
+        try
+        {
+            parseFootprint( item );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            // Leave broken footprints out of the library, as Load() does, and keep their
+            // errors for the next enumeration
+            if( !m_parseErrors.IsEmpty() )
+                m_parseErrors += wxT( "\n\n" );
+
+            m_parseErrors += ioe.What();
+            m_footprints.erase( it );
+            throw;
+        }
+
+        if( !aPin )
+        {
+            m_lru.push_front( aFootprintName );
+            item.m_lruEntry = m_lru.begin();
+            item.m_evictable = true;
+        }
+    }
+    else if( item.m_evictable && aPin )
+    {
+        // Someone now holds on to this footprint: it must not be released anymore
+        m_lru.erase( item.m_lruEntry );
+        item.m_evictable = false;
+    }
+    else if( item.m_evictable )
+    {
+        m_lru.splice( m_lru.begin(), m_lru, item.m_lruEntry );
+    }
+
+    size_t maxParsed = std::max( ADVANCED_CFG::GetCfg().m_FootprintCacheSize, 0 );
+
+    // Release the least recently used footprints.  Entries of footprints which have since been
+    // removed from the cache are simply dropped.  The footprint just requested is either pinned
+    // or at the front of the list so it is never released here.
+    while( maxParsed > 0 && m_lru.size() > maxParsed )
+    {
+        FP_CACHE_FOOTPRINT_MAP::iterator lruIt = m_footprints.find( m_lru.back() );
+
+        if( lruIt != m_footprints.end() && lruIt->second->m_evictable
+                && lruIt->second->m_lruEntry == std::prev( m_lru.end() ) )
+        {
+            lruIt->second->m_footprint.reset();
+            lruIt->second->m_evictable = false;
+        }
+
+        m_lru.pop_back();
+    }
+
+    return item.m_footprint.get();
+}
+
+
+void FP_CACHE::parseFootprint( FP_CACHE_ITEM& aItem )
+{
+    wxString fullPath = aItem.m_filename.GetFullPath();
+
+    try
+    {
+        FILE_LINE_READER          reader( fullPath );
+        PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+        std::unique_ptr<BOARD_ITEM> item( parser.Parse() );
+        FOOTPRINT*                  footprint = dynamic_cast<FOOTPRINT*>( item.get() );
+
+        if( !footprint )
+            THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+
+        item.release();
+        footprint->SetFPID( LIB_ID( wxEmptyString, aItem.m_filename.GetName() ) );
+        aItem.m_footprint.reset( footprint );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ) + '\n', fullPath )
+                        + ioe.What() );
+    }
+}
+
 
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+void FP_CACHE::loadAll()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
+    {
+        FP_CACHE_ITEM& item = *it->second;
+
+        if( !item.m_footprint )
+            parseFootprint( item );
+        else if( item.m_evictable )
+            m_lru.erase( item.m_lruEntry );
+
+        item.m_evictable = false;
     }
 }
 
 
 void FP_CACHE::Remove( const wxString& aFootprintName )
 {
+    std::lock_guard<std::mutex> lock( m_mutex );
+
     FP_CACHE_FOOTPRINT_MAP::const_iterator it = m_footprints.find( aFootprintName );
 
     if( it == m_footprints.end() )
@@ -262,6 +415,8 @@ void FP_CACHE::SetPath( const wxString& aPath )
     m_lib_raw_path = aPath;
     m_lib_path.SetPath( aPath );
 
+    // The footprints can no longer be read from their old location once the path changes
+    loadAll();
 
     for( const auto& footprint : GetFootprints() )
     {
@@ -2704,7 +2859,7 @@ void PCB_IO_KICAD_SEXPR::validateCache( const wxString& aLibraryPath, bool check
         // a spectacular episode in memory management:
         delete m_cache;
         m_cache = new FP_CACHE( this, aLibraryPath );
-        m_cache->Load();
+        m_cache->Enumerate();
     }
 }
 
@@ -2727,8 +2882,17 @@ void PCB_IO_KICAD_SEXPR::FootprintEnumerate( wxArrayString& aFootprintNames, con
         errorMsg = ioe.What();
     }
 
-    // Some of the files may have been parsed correctly so we want to add the valid files to
-    // the library.
+    // Footprints are only parsed when they are used, so the files which failed to parse so far
+    // are reported here and the others, parsed or not, are listed.
+    wxString parseErrors = m_cache->GetParseErrors();
+
+    if( !parseErrors.IsEmpty() )
+    {
+        if( !errorMsg.IsEmpty() )
+            errorMsg += wxT( "\n\n" );
+
+        errorMsg += parseErrors;
+    }
 
     for( const auto& footprint : m_cache->GetFootprints() )
         aFootprintNames.Add( footprint.first );
@@ -2741,7 +2905,7 @@ void PCB_IO_KICAD_SEXPR::FootprintEnumerate( wxArrayString& aFootprintNames, con
 const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
                                            const wxString& aFootprintName,
                                            const std::map<std::string, UTF8>* aProperties,
-                                           bool checkModified )
+                                           bool checkModified, bool aPin )
 {
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
@@ -2756,13 +2920,7 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
         // do nothing with the error
     }
 
-    FP_CACHE_FOOTPRINT_MAP&       footprints = m_cache->GetFootprints();
-    FP_CACHE_FOOTPRINT_MAP::const_iterator it = footprints.find( aFootprintName );
-
-    if( it == footprints.end() )
-        return nullptr;
-
-    return it->second->GetFootprint();
+    return m_cache->GetFootprint( aFootprintName, aPin );
 }
 
 
@@ -2770,7 +2928,31 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::GetEnumeratedFootprint( const wxString& aLi
                                                      const wxString& aFootprintName,
                                                      const std::map<std::string, UTF8>* aProperties )
 {
-    return getFootprint( aLibraryPath, aFootprintName, aProperties, false );
+    // The caller keeps the returned pointer, so it must never be released by the cache
+    return getFootprint( aLibraryPath, aFootprintName, aProperties, false, true );
+}
+
+
+bool PCB_IO_KICAD_SEXPR::VisitEnumeratedFootprint( const wxString& aLibraryPath,
+                                                   const wxString& aFootprintName,
+                                                   const std::function<void( const FOOTPRINT& )>& aVisitor,
+                                                   const std::map<std::string, UTF8>* aProperties )
+{
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    try
+    {
+        validateCache( aLibraryPath, false );
+    }
+    catch( const IO_ERROR& )
+    {
+        // do nothing with the error
+    }
+
+    // The footprint is only read while the cache is locked, so it doesn't need to be pinned
+    return m_cache->VisitFootprint( aFootprintName, aVisitor );
 }
 
 
@@ -30,6 +30,8 @@
 #include <ctl_flags.h>
 
 #include <richio.h>
+#include <list>
+#include <mutex>
 #include <string>
 #include <layer_ids.h>
 #include <lset.h>
@@ -193,14 +195,24 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
  */
 class FP_CACHE_ITEM
 {
-    WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    WX_FILENAME                   m_filename;
+    std::unique_ptr<FOOTPRINT>    m_footprint;  ///< Null until the footprint file is parsed.
+    bool                          m_evictable;  ///< The footprint can be released and parsed
+                                                ///< again from m_filename.
+    std::list<wxString>::iterator m_lruEntry;   ///< Entry in FP_CACHE::m_lru if evictable.
+
+    friend class FP_CACHE;
 
 public:
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
     const WX_FILENAME& GetFileName() const { return m_filename; }
     void               SetFilePath( const wxString& aFilePath ) { m_filename.SetPath( aFilePath ); }
+
+    /**
+     * @return the footprint, or nullptr if it has not been parsed yet.  Use
+     *         FP_CACHE::GetFootprint() to parse it on demand.
+     */
     const FOOTPRINT*   GetFootprint() const { return m_footprint.get(); }
 };
 
@@ -218,6 +230,13 @@ class FP_CACHE
     long long m_cache_timestamp; // A hash of the timestamps for all the footprint
                                  // files.
 
+    std::list<wxString> m_lru;   // Names of the evictable parsed footprints, most recently
+                                 // used first.
+    std::mutex          m_mutex; // Guards the parsing and releasing of footprints.
+
+    wxString m_parseErrors;      // Errors of the footprints which failed to parse (and were
+                                 // dropped from the cache).
+
 public:
     FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath );
 
@@ -240,8 +259,53 @@ public:
      */
     void Save( FOOTPRINT* aFootprint = nullptr );
 
+    /**
+     * Enumerate the footprint files of the library and parse all of them.
+     *
+     * Footprints which cannot be parsed are left out of the cache.
+     *
+     * @throw IO_ERROR if the library cannot be read or if any footprint failed to parse.
+     */
     void Load();
 
+    /**
+     * Enumerate the footprint files of the library without parsing them.
+     *
+     * The footprints are parsed on first access through GetFootprint() and the least recently
+     * used ones are released again once more than ADVANCED_CFG::m_FootprintCacheSize of them
+     * have been parsed.
+     *
+     * @throw IO_ERROR if the library cannot be read.
+     */
+    void Enumerate();
+
+    /**
+     * Return the footprint \a aFootprintName, parsing its file if it is not in memory.
+     *
+     * @param aPin set to keep the footprint in memory for the lifetime of the cache.  Otherwise
+     *             the returned pointer only remains valid until the next call to GetFootprint(),
+     *             which may release it.
+     * @return the footprint or nullptr if the library has no footprint \a aFootprintName.
+     * @throw IO_ERROR if the footprint file cannot be parsed.
+     */
+    const FOOTPRINT* GetFootprint( const wxString& aFootprintName, bool aPin = false );
+
+    /**
+     * Call \a aVisitor with the footprint \a aFootprintName, parsing its file if it is not in
+     * memory.  The footprint is not pinned, and cannot be released while \a aVisitor runs.
+     *
+     * @return false if the library has no footprint \a aFootprintName.
+     * @throw IO_ERROR if the footprint file cannot be parsed.
+     */
+    bool VisitFootprint( const wxString& aFootprintName,
+                         const std::function<void( const FOOTPRINT& )>& aVisitor );
+
+    /**
+     * @return the errors of the footprints which failed to parse since the library was
+     *         enumerated.  These footprints are no longer in the cache.
+     */
+    wxString GetParseErrors();
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -270,6 +334,26 @@ public:
     bool IsPath( const wxString& aPath ) const;
 
     void SetPath( const wxString& aPath );
+
+private:
+    /**
+     * Parse the footprint file of \a aItem.
+     *
+     * @throw IO_ERROR if the file cannot be read or does not contain a footprint.
+     */
+    void parseFootprint( FP_CACHE_ITEM& aItem );
+
+    /**
+     * GetFootprint() without locking m_mutex.  Footprints which fail to parse are removed from
+     * the cache and their errors are kept for GetParseErrors().
+     */
+    const FOOTPRINT* findFootprint( const wxString& aFootprintName, bool aPin );
+
+    /**
+     * Parse all the footprints not yet in memory and keep them there.  Needed before the
+     * footprint files are moved or rewritten.
+     */
+    void loadAll();
 };
 
 
@@ -324,6 +408,10 @@ public:
                                              const wxString& aFootprintName,
                                              const std::map<std::string, UTF8>* aProperties = nullptr ) override;
 
+    bool VisitEnumeratedFootprint( const wxString& aLibraryPath, const wxString& aFootprintName,
+                                   const std::function<void( const FOOTPRINT& )>& aVisitor,
+                                   const std::map<std::string, UTF8>* aProperties = nullptr ) override;
+
     bool FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                           const std::map<std::string, UTF8>* aProperties = nullptr ) override;
 
@@ -381,7 +469,8 @@ protected:
     void validateCache( const wxString& aLibraryPath, bool checkModified = true );
 
     const FOOTPRINT* getFootprint( const wxString& aLibraryPath, const wxString& aFootprintName,
-                                   const std::map<std::string, UTF8>* aProperties, bool checkModified );
+                                   const std::map<std::string, UTF8>* aProperties, bool checkModified,
+                                   bool aPin = false );
 
     void init( const std::map<std::string, UTF8>* aProperties );
 
@@ -138,6 +138,23 @@ const FOOTPRINT* PCB_IO::GetEnumeratedFootprint( const wxString& aLibraryPath,
 }
 
 
+bool PCB_IO::VisitEnumeratedFootprint( const wxString& aLibraryPath,
+                                       const wxString& aFootprintName,
+                                       const std::function<void( const FOOTPRINT& )>& aVisitor,
+                                       const std::map<std::string, UTF8>* aProperties )
+{
+    // default implementation
+    const FOOTPRINT* footprint = GetEnumeratedFootprint( aLibraryPath, aFootprintName,
+                                                         aProperties );
+
+    if( !footprint )
+        return false;
+
+    aVisitor( *footprint );
+    return true;
+}
+
+
 bool PCB_IO::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                               const std::map<std::string, UTF8>* aProperties )
 {
@@ -29,6 +29,7 @@
 #include <pcb_io/pcb_io_mgr.h>
 
 #include <cstdint>
+#include <functional>
 #include <config.h>
 #include <vector>
 #include <wx/arrstr.h>
@@ -258,6 +259,19 @@ public:
                                                      const wxString& aFootprintName,
                                                      const std::map<std::string, UTF8>* aProperties = nullptr );
 
+    /**
+     * Call \a aVisitor with a footprint, for callers of FootprintEnumerate() which only need to
+     * read the footprint once.  Unlike GetEnumeratedFootprint(), the plugin does not have to
+     * keep the footprint once \a aVisitor returns.
+     *
+     * @return false if the footprint was not found.
+     * @throw IO_ERROR if the footprint cannot be read.
+     */
+    virtual bool VisitEnumeratedFootprint( const wxString& aLibraryPath,
+                                           const wxString& aFootprintName,
+                                           const std::function<void( const FOOTPRINT& )>& aVisitor,
+                                           const std::map<std::string, UTF8>* aProperties = nullptr );
+
     /**
      * Check for the existence of a footprint.
      */
@@ -220,6 +220,9 @@ bool PCB_IO_MGR::ConvertLibrary( std::map<std::string, UTF8>* aOldFileProps, con
             std::unique_ptr<const FOOTPRINT> fp(
                 oldFilePI->GetEnumeratedFootprint( aOldFilePath, fpName, aOldFileProps ) );
 
+            if( !fp )
+                continue;
+
             try
             {
                 kicadPI->FootprintSave( aNewFilePath, fp.get(), &props );
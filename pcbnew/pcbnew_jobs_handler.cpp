@@ -40,7 +40,10 @@
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
 #include <lset.h>
+#include <locale_io.h>
 #include <cli/exit_codes.h>
+#include <core/ignore.h>
+#include <core/thread_pool.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
 #include <plotters/plotter_dxf.h>
@@ -86,7 +89,8 @@
 
 
 PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
-        JOB_DISPATCHER( aKiway )
+        JOB_DISPATCHER( aKiway ),
+        m_cachedBoardModified( false )
 {
     Register( "3d", std::bind( &PCBNEW_JOBS_HANDLER::JobExportStep, this, std::placeholders::_1 ) );
     Register( "render", std::bind( &PCBNEW_JOBS_HANDLER::JobExportRender, this, std::placeholders::_1 ) );
@@ -110,6 +114,45 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
 }
 
 
+PCBNEW_JOBS_HANDLER::~PCBNEW_JOBS_HANDLER()
+{
+    // The handler is only destroyed when the kiface is unloaded, by which time the board's
+    // dependencies may already be gone.  Leave it to the process, as before boards were cached.
+    ignore_unused( m_cachedBoard.release() );
+}
+
+
+BOARD* PCBNEW_JOBS_HANDLER::getBoard( wxString& aFileName )
+{
+    wxFileName fn( aFileName );
+    fn.MakeAbsolute();
+
+    wxDateTime modTime = fn.FileExists() ? fn.GetModificationTime() : wxDateTime();
+
+    if( m_cachedBoard && !m_cachedBoardModified && m_cachedBoardPath == fn.GetFullPath()
+            && modTime.IsValid() && modTime == m_cachedBoardModTime )
+    {
+        PROJECT_FILE& projectFile = m_cachedBoard->GetProject()->GetProjectFile();
+
+        // A previous job may have overridden the drawing sheet and the text variables
+        loadOverrideDrawingSheet( m_cachedBoard.get(), projectFile.m_BoardDrawingSheetFile );
+        projectFile.m_TextVars = m_cachedBoardTextVars;
+
+        return m_cachedBoard.get();
+    }
+
+    m_cachedBoard.reset( LoadBoard( aFileName, true ) );
+    m_cachedBoardPath = fn.GetFullPath();
+    m_cachedBoardModTime = modTime;
+    m_cachedBoardModified = false;
+
+    if( m_cachedBoard )
+        m_cachedBoardTextVars = m_cachedBoard->GetProject()->GetTextVars();
+
+    return m_cachedBoard.get();
+}
+
+
 int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
 {
     JOB_EXPORT_PCB_3D* aStepJob = dynamic_cast<JOB_EXPORT_PCB_3D*>( aJob );
@@ -120,7 +163,7 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aStepJob->m_filename, true );
+    BOARD* brd = getBoard( aStepJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -234,7 +277,7 @@ int PCBNEW_JOBS_HANDLER::JobExportRender( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aRenderJob->m_filename, true );
+    BOARD* brd = getBoard( aRenderJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -430,7 +473,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aSvgJob->m_filename, true );
+    BOARD* brd = getBoard( aSvgJob->m_filename );
     loadOverrideDrawingSheet( brd, aSvgJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -457,7 +500,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aDxfJob->m_filename, true );
+    BOARD* brd = getBoard( aDxfJob->m_filename );
     loadOverrideDrawingSheet( brd, aDxfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -533,7 +576,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aPdfJob->m_filename, true );
+    BOARD* brd = getBoard( aPdfJob->m_filename );
     loadOverrideDrawingSheet( brd, aPdfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -628,7 +671,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aGerberJob->m_filename, true );
+    BOARD* brd = getBoard( aGerberJob->m_filename );
     loadOverrideDrawingSheet( brd, aGerberJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -660,75 +703,123 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             aGerberJob->m_layersIncludeOnAll = plotOnAllLayersSelection;
     }
 
+    // Everything touching the job, the reporter or the job file is set up here, in layer order;
+    // only the plots themselves run on the thread pool.
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID    layer;
+        LSEQ            plotSequence;
+        wxString        layerName;
+        wxString        sheetName;
+        wxString        sheetPath;
+        wxString        fullPath;
+        PCB_PLOT_PARAMS plotOpts;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+
     for( PCB_LAYER_ID layer : LSET( { aGerberJob->m_printMaskLayer } ).UIOrder() )
     {
-        LSEQ plotSequence;
+        LAYER_PLOT& layerPlot = layerPlots.emplace_back();
+        layerPlot.layer = layer;
 
         // Base layer always gets plotted first.
-        plotSequence.push_back( layer );
+        layerPlot.plotSequence.push_back( layer );
 
         // Now all the "include on all" layers
         for( PCB_LAYER_ID layer_all : aGerberJob->m_layersIncludeOnAll.UIOrder() )
         {
             // Don't plot the same layer more than once;
-            if( find( plotSequence.begin(), plotSequence.end(), layer_all ) != plotSequence.end() )
+            if( find( layerPlot.plotSequence.begin(), layerPlot.plotSequence.end(), layer_all )
+                    != layerPlot.plotSequence.end() )
+            {
                 continue;
+            }
 
-            plotSequence.push_back( layer_all );
+            layerPlot.plotSequence.push_back( layer_all );
         }
 
         // Pick the basename from the board file
-        wxFileName      fn( brd->GetFileName() );
-        wxString        layerName = brd->GetLayerName( layer );
-        wxString        sheetName;
-        wxString        sheetPath;
-        PCB_PLOT_PARAMS plotOpts;
+        wxFileName fn( brd->GetFileName() );
+        layerPlot.layerName = brd->GetLayerName( layer );
 
         if( aGerberJob->m_useBoardPlotParams )
-            plotOpts = boardPlotOptions;
+            layerPlot.plotOpts = boardPlotOptions;
         else
-            populateGerberPlotOptionsFromJob( plotOpts, aGerberJob );
+            populateGerberPlotOptionsFromJob( layerPlot.plotOpts, aGerberJob );
 
-        if( plotOpts.GetUseGerberProtelExtensions() )
+        if( layerPlot.plotOpts.GetUseGerberProtelExtensions() )
             fileExt = GetGerberProtelExtension( layer );
         else
             fileExt = FILEEXT::GerberFileExtension;
 
-        BuildPlotFileName( &fn, aGerberJob->m_outputFile, layerName, fileExt );
+        BuildPlotFileName( &fn, aGerberJob->m_outputFile, layerPlot.layerName, fileExt );
         wxString fullname = fn.GetFullName();
 
         jobfile_writer.AddGbrFile( layer, fullname );
 
         if( aJob->GetVarOverrides().contains( wxT( "LAYER" ) ) )
-            layerName = aJob->GetVarOverrides().at( wxT( "LAYER" ) );
+            layerPlot.layerName = aJob->GetVarOverrides().at( wxT( "LAYER" ) );
 
         if( aJob->GetVarOverrides().contains( wxT( "SHEETNAME" ) ) )
-            sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
+            layerPlot.sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
 
         if( aJob->GetVarOverrides().contains( wxT( "SHEETPATH" ) ) )
-            sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
+            layerPlot.sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
+
+        layerPlot.fullPath = fn.GetFullPath();
+    }
+
+    // The board is only read while plotting, but a few of its caches are filled lazily.  Fill
+    // them now so the plot threads never write to it.
+    PrepareBoardForConcurrentPlot( brd );
+
+    // The numeric locale is process-wide: keep it set for the whole time the plot threads run
+    LOCALE_IO toggle;
+
+    auto plotLayer =
+            [brd]( LAYER_PLOT* aLayerPlot ) -> bool
+            {
+                // We are feeding it one layer at the start here to silence a logic check
+                PLOTTER* plotter = StartPlotBoard( brd, &aLayerPlot->plotOpts, aLayerPlot->layer,
+                                                   aLayerPlot->layerName, aLayerPlot->fullPath,
+                                                   aLayerPlot->sheetName, aLayerPlot->sheetPath );
+
+                if( !plotter )
+                    return false;
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer,
-                                                                    layerName, fn.GetFullPath(),
-                                                                    sheetName, sheetPath );
+                PlotBoardLayers( brd, plotter, aLayerPlot->plotSequence, aLayerPlot->plotOpts );
+                plotter->EndPlot();
+
+                delete plotter->RenderSettings();
+                delete plotter;
+                return true;
+            };
 
-        if( plotter )
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<bool>> returns;
+
+    returns.reserve( layerPlots.size() );
+
+    for( LAYER_PLOT& layerPlot : layerPlots )
+        returns.emplace_back( tp.submit( plotLayer, &layerPlot ) );
+
+    // Report in layer order, whatever order the plots finish in
+    for( size_t ii = 0; ii < layerPlots.size(); ++ii )
+    {
+        if( returns[ii].get() )
         {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ),
+                                                  layerPlots[ii].fullPath ),
                                 RPT_SEVERITY_ACTION );
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
             m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
-                                                  fn.GetFullPath() ),
+                                                  layerPlots[ii].fullPath ),
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
-
-        delete plotter;
     }
 
     wxFileName fn( aGerberJob->m_filename );
@@ -776,7 +867,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aGerberJob->m_filename, true );
+    BOARD* brd = getBoard( aGerberJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -850,7 +941,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aDrillJob->m_filename, true );
+    BOARD* brd = getBoard( aDrillJob->m_filename );
 
     // ensure output dir exists
     wxFileName fn( aDrillJob->m_outputDir + wxT( "/" ) );
@@ -969,7 +1060,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPos( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aPosJob->m_filename, true );
+    BOARD* brd = getBoard( aPosJob->m_filename );
 
     if( aPosJob->m_outputFile.IsEmpty() )
     {
@@ -1273,7 +1364,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( drcJob->m_filename, true );
+    BOARD* brd = getBoard( drcJob->m_filename );
+    m_cachedBoardModified = true;     // DRC markers are added to the board
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -1441,7 +1533,7 @@ int PCBNEW_JOBS_HANDLER::JobExportIpc2581( JOB* aJob )
     if( job->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( job->m_filename, true );
+    BOARD* brd = getBoard( job->m_filename );
 
     if( job->m_outputFile.IsEmpty() )
     {
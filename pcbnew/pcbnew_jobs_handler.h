@@ -23,6 +23,10 @@
 
 #include <jobs/job_dispatcher.h>
 #include <pcb_plot_params.h>
+#include <wx/datetime.h>
+
+#include <map>
+#include <memory>
 
 class KIWAY;
 class BOARD;
@@ -35,6 +39,8 @@ class PCBNEW_JOBS_HANDLER : public JOB_DISPATCHER
 {
 public:
     PCBNEW_JOBS_HANDLER( KIWAY* aKiway );
+    ~PCBNEW_JOBS_HANDLER();
+
     int JobExportStep( JOB* aJob );
     int JobExportRender( JOB* aJob );
     int JobExportSvg( JOB* aJob );
@@ -50,12 +56,29 @@ public:
     int JobExportIpc2581( JOB* aJob );
 
 private:
+    /**
+     * Return the board for \a aFileName, loading it only if it is not the board used by the
+     * previous job (or if that board was modified by its job or has changed on disk).
+     *
+     * A reused board gets back the drawing sheet and the text variables of its project, which
+     * the previous job may have overridden.  The board is owned by the handler.
+     */
+    BOARD* getBoard( wxString& aFileName );
+
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS&       aPlotOpts,
                                            JOB_EXPORT_PCB_GERBER* aJob );
     int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint );
     void loadOverrideDrawingSheet( BOARD* brd, const wxString& aSheetPath );
 
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( BOARD* aBrd );
+
+    std::unique_ptr<BOARD> m_cachedBoard;
+    wxString               m_cachedBoardPath;
+    wxDateTime             m_cachedBoardModTime;
+    bool                   m_cachedBoardModified;  ///< set by jobs that change the board
+
+    /// The project text variables as loaded, before any job overrides them
+    std::map<wxString, wxString> m_cachedBoardTextVars;
 };
 
 #endif
\ No newline at end of file
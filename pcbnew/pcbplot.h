@@ -158,6 +158,15 @@ PLOTTER* StartPlotBoard( BOARD* aBoard, const PCB_PLOT_PARAMS* aPlotOpts, int aL
                          const wxString& aLayerName, const wxString& aFullFileName,
                          const wxString& aSheetName, const wxString& aSheetPath );
 
+/**
+ * Fill the caches which are built lazily by the board items while they are plotted (bounding
+ * boxes, hulls and text glyphs).
+ *
+ * Call this before plotting several layers of \a aBoard at the same time, so the plots only
+ * read the board.
+ */
+void PrepareBoardForConcurrentPlot( BOARD* aBoard );
+
 /**
  * Plot a sequence of board layer IDs.
  *
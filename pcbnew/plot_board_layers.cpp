@@ -23,6 +23,8 @@
 
 #include <wx/log.h>
 #include <eda_item.h>
+#include <eda_text.h>
+#include <font/font.h>
 #include <layer_ids.h>
 #include <lset.h>
 #include <geometry/geometry_utils.h>
@@ -46,6 +48,8 @@
 #include <gbr_metadata.h>
 #include <advanced_config.h>
 
+#include <mutex>
+
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
  * drawn like standard layers, unless the minimum thickness is 0.
@@ -53,6 +57,52 @@
 static void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                                  const PCB_PLOT_PARAMS& aPlotOpt, int aMinThickness );
 
+/// Serialize the parts of a plot which touch state shared between plots of different layers
+static std::mutex s_boardOutlinesMutex;
+static std::mutex s_drawingSheetMutex;
+
+
+void PrepareBoardForConcurrentPlot( BOARD* aBoard )
+{
+    aBoard->ComputeBoundingBox( false, false );
+
+    // Outline font texts keep their glyphs in a render cache which is rebuilt on demand
+    auto cacheText =
+            []( BOARD_ITEM* aItem )
+            {
+                EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aItem );
+
+                if( !text )
+                    return;
+
+                KIFONT::FONT* font = text->GetFont();
+
+                if( font && font->IsOutline() )
+                    text->GetRenderCache( font, text->GetShownText( true ) );
+            };
+
+    auto cacheItem =
+            [&]( BOARD_ITEM* aItem )
+            {
+                cacheText( aItem );
+
+                if( aItem->Type() == PCB_TABLE_T )
+                    aItem->RunOnChildren( cacheText );
+            };
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+        cacheItem( item );
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        footprint->GetBoundingBox( true, true );
+        footprint->GetBoundingBox( true, false );
+        footprint->GetBoundingBox( false, false );
+        footprint->GetBoundingHull();
+        footprint->RunOnChildren( cacheItem );
+    }
+}
+
 
 void PlotBoardLayers( BOARD* aBoard, PLOTTER* aPlotter, const LSEQ& aLayers,
                       const PCB_PLOT_PARAMS& aPlotOptions )
@@ -307,11 +357,11 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         itemplotter.PlotFootprintGraphicItems( footprint );
 
     // Plot footprint pads
-    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
     {
         aPlotter->StartBlock( nullptr );
 
-        for( PAD* pad : footprint->Pads() )
+        for( const PAD* pad : footprint->Pads() )
         {
             OUTLINE_MODE padPlotMode = plotMode;
 
@@ -386,14 +436,6 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             // Now offset the pad size by margin + width_adj
             VECTOR2I padPlotsSize = pad->GetSize() + margin * 2 + VECTOR2I( width_adj, width_adj );
 
-            // Store these parameters that can be modified to plot inflated/deflated pads shape
-            PAD_SHAPE padShape = pad->GetShape();
-            VECTOR2I  padSize = pad->GetSize();
-            VECTOR2I  padDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
-            // CornerRadius and CornerRadiusRatio can be modified
-            // the radius is built from the ratio, so saving/restoring the ratio is enough
-            double    padCornerRadiusRatio = pad->GetRoundRectRadiusRatio();
-
             // Don't draw a 0 sized pad.
             // Note: a custom pad can have its pad anchor with size = 0
             if( pad->GetShape() != PAD_SHAPE::CUSTOM
@@ -402,33 +444,54 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 continue;
             }
 
+            // Inflated/deflated pad shapes are plotted from a copy of the pad, so the board
+            // itself is never modified during a plot and several layers can be plotted at once.
+            auto plotResizedPad =
+                    [&]( const std::function<void( PAD& )>& aResize )
+                    {
+                        if( padPlotsSize == pad->GetSize() && mask_clearance <= 0 )
+                        {
+                            itemplotter.PlotPad( pad, color, padPlotMode );
+                            return;
+                        }
+
+                        PAD dummy( *pad );
+                        dummy.SetParentGroup( nullptr );
+                        aResize( dummy );
+                        itemplotter.PlotPad( &dummy, color, padPlotMode );
+                    };
+
             switch( pad->GetShape() )
             {
             case PAD_SHAPE::CIRCLE:
             case PAD_SHAPE::OVAL:
-                pad->SetSize( padPlotsSize );
-
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
+                    ( padPlotsSize == pad->GetDrillSize() ) &&
                     ( pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
                 {
                     break;
                 }
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                plotResizedPad(
+                        [&]( PAD& aPad )
+                        {
+                            aPad.SetSize( padPlotsSize );
+                        } );
                 break;
 
             case PAD_SHAPE::RECTANGLE:
-                pad->SetSize( padPlotsSize );
-
-                if( mask_clearance > 0 )
-                {
-                    pad->SetShape( PAD_SHAPE::ROUNDRECT );
-                    pad->SetRoundRectCornerRadius( mask_clearance );
-                }
-
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                plotResizedPad(
+                        [&]( PAD& aPad )
+                        {
+                            aPad.SetSize( padPlotsSize );
+
+                            if( mask_clearance > 0 )
+                            {
+                                aPad.SetShape( PAD_SHAPE::ROUNDRECT );
+                                aPad.SetRoundRectCornerRadius( mask_clearance );
+                            }
+                        } );
                 break;
 
             case PAD_SHAPE::TRAPEZOID:
@@ -443,6 +506,8 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 }
                 else
                 {
+                    VECTOR2I padSize = pad->GetSize();
+                    VECTOR2I padDelta = pad->GetDelta();
                     PAD dummy( *pad );
                     dummy.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
                     dummy.SetShape( PAD_SHAPE::CUSTOM );
@@ -477,24 +542,27 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 break;
 
             case PAD_SHAPE::ROUNDRECT:
-            {
-                // rounding is stored as a percent, but we have to update this ratio
-                // to force recalculation of other values after size changing (we do not
-                // really change the rounding percent value)
-                double radius_ratio = pad->GetRoundRectRadiusRatio();
-                pad->SetSize( padPlotsSize );
-                pad->SetRoundRectRadiusRatio( radius_ratio );
-
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                plotResizedPad(
+                        [&]( PAD& aPad )
+                        {
+                            // rounding is stored as a percent, but we have to update this ratio
+                            // to force recalculation of other values after size changing (we do
+                            // not really change the rounding percent value)
+                            double radius_ratio = aPad.GetRoundRectRadiusRatio();
+                            aPad.SetSize( padPlotsSize );
+                            aPad.SetRoundRectRadiusRatio( radius_ratio );
+                        } );
                 break;
-            }
 
             case PAD_SHAPE::CHAMFERED_RECT:
                 if( mask_clearance == 0 )
                 {
                     // the size can be slightly inflated by width_adj (PS/PDF only)
-                    pad->SetSize( padPlotsSize );
-                    itemplotter.PlotPad( pad, color, padPlotMode );
+                    plotResizedPad(
+                            [&]( PAD& aPad )
+                            {
+                                aPad.SetSize( padPlotsSize );
+                            } );
                 }
                 else
                 {
@@ -563,12 +631,6 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 break;
             }
             }
-
-            // Restore the pad parameters modified by the plot code
-            pad->SetSize( padSize );
-            pad->SetDelta( padDelta );
-            pad->SetShape( padShape );
-            pad->SetRoundRectRadiusRatio( padCornerRadiusRatio );
         }
 
         if( footprint->IsDNP()
@@ -849,8 +911,14 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
 
-    if( aBoard->GetBoardPolygonOutlines( buffer ) )
-        boardOutline = &buffer;
+    {
+        // Building the outlines flags the board shapes, so layers plotted concurrently have to
+        // take turns here
+        std::lock_guard<std::mutex> lock( s_boardOutlinesMutex );
+
+        if( aBoard->GetBoardPolygonOutlines( buffer ) )
+            boardOutline = &buffer;
+    }
 
     // We remove 1nm as we expand both sides of the shapes, so allowing for a strictly greater
     // than or equal comparison in the shape separation (boolean add)
@@ -1264,6 +1332,10 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, const PCB_PLOT_PARAMS *aPlotOpts, int aL
             // Plot the frame reference if requested
             if( aPlotOpts->GetPlotFrameRef() )
             {
+                // The drawing sheet model is a global which rebuilds its draw items for
+                // every plot
+                std::lock_guard<std::mutex> lock( s_drawingSheetMutex );
+
                 PlotDrawingSheet( plotter, aBoard->GetProject(), aBoard->GetTitleBlock(),
                                   aBoard->GetPageSettings(), &aBoard->GetProperties(), wxT( "1" ),
                                   1, aSheetName, aSheetPath, aBoard->GetFileName(),
@@ -40,6 +40,7 @@ using namespace std::placeholders;
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
 
 #include <delaunator.hpp>
@@ -139,6 +140,21 @@ class RN_NET::TRIANGULATOR_STATE
 private:
     std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> m_allNodes;
 
+    struct TRIANGLE
+    {
+        int      v[3];      ///< indices into m_points
+        VECTOR2D center;    ///< circumcircle center
+        double   radiusSq;  ///< squared circumcircle radius, slightly inflated
+    };
+
+    ///< Unique anchor positions of the last triangulation, sorted as m_allNodes
+    std::vector<VECTOR2I> m_points;
+
+    ///< Delaunay triangles of m_points (possibly with a few redundant extra triangles)
+    std::vector<TRIANGLE> m_triangles;
+
+    ///< Don't repair the triangulation if more than 1/N of the points have changed
+    static constexpr size_t MAX_CHANGED_FRACTION = 8;
 
     // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
     // have unique coordinates!
@@ -161,6 +177,294 @@ private:
         return true;
     }
 
+    static TRIANGLE makeTriangle( const std::vector<VECTOR2I>& aPoints, int aA, int aB, int aC )
+    {
+        TRIANGLE t;
+        t.v[0] = aA;
+        t.v[1] = aB;
+        t.v[2] = aC;
+
+        // Circumcircle, computed relative to the first vertex to limit the rounding errors
+        const VECTOR2D a( aPoints[aA] );
+        const VECTOR2D b = VECTOR2D( aPoints[aB] ) - a;
+        const VECTOR2D c = VECTOR2D( aPoints[aC] ) - a;
+
+        double d = 2.0 * ( b.x * c.y - b.y * c.x );
+
+        if( d == 0.0 )
+        {
+            // Degenerate; make it conflict with everything so it gets rebuilt on the next update
+            t.center = a;
+            t.radiusSq = std::numeric_limits<double>::infinity();
+            return t;
+        }
+
+        double bb = b.x * b.x + b.y * b.y;
+        double cc = c.x * c.x + c.y * c.y;
+
+        VECTOR2D center( ( c.y * bb - b.y * cc ) / d, ( b.x * cc - c.x * bb ) / d );
+
+        t.center = a + center;
+
+        // Inflate the circle a bit: a false conflict only costs a slightly larger local repair,
+        // while a missed one would leave a non-Delaunay triangle behind.
+        t.radiusSq = ( center.x * center.x + center.y * center.y ) * ( 1.0 + 1e-9 ) + 1.0;
+
+        return t;
+    }
+
+    bool inCircumcircle( const TRIANGLE& aTriangle, const VECTOR2I& aP ) const
+    {
+        double dx = aP.x - aTriangle.center.x;
+        double dy = aP.y - aTriangle.center.y;
+
+        return dx * dx + dy * dy <= aTriangle.radiusSq;
+    }
+
+    /**
+     * Triangulate a subset of \a aPoints given by \a aSubset, appending the triangles to
+     * \a aTriangles.
+     *
+     * @return false if the subset has no triangulation (less than 3 points or all colinear).
+     */
+    bool triangulate( const std::vector<VECTOR2I>& aPoints, const std::vector<int>& aSubset,
+                      std::vector<TRIANGLE>& aTriangles ) const
+    {
+        if( aSubset.size() < 3 )
+            return false;
+
+        std::vector<double> coords;
+        coords.reserve( 2 * aSubset.size() );
+
+        bool           colinear = true;
+        const VECTOR2I p0 = aPoints[aSubset[0]];
+        const VECTOR2I v0 = aPoints[aSubset[1]] - p0;
+
+        for( int idx : aSubset )
+        {
+            coords.push_back( aPoints[idx].x );
+            coords.push_back( aPoints[idx].y );
+
+            if( colinear && v0.Cross( aPoints[idx] - p0 ) != 0 )
+                colinear = false;
+        }
+
+        if( colinear )
+            return false;
+
+        delaunator::Delaunator delaunator( coords );
+        const std::vector<size_t>& triangles = delaunator.triangles;
+
+        for( size_t i = 0; i < triangles.size(); i += 3 )
+        {
+            aTriangles.push_back( makeTriangle( aPoints, aSubset[triangles[i]],
+                                                aSubset[triangles[i + 1]],
+                                                aSubset[triangles[i + 2]] ) );
+        }
+
+        return true;
+    }
+
+    /**
+     * @return the indices of the convex hull vertices of \a aPoints, which must be sorted by
+     *         x then y.  Points lying on a hull edge are not included.
+     */
+    static std::vector<int> convexHull( const std::vector<VECTOR2I>& aPoints )
+    {
+        int              n = aPoints.size();
+        std::vector<int> hull( 2 * n );
+        int              k = 0;
+
+        if( n < 3 )
+            return {};
+
+        auto turnsLeft =
+                [&]( int aA, int aB, int aC )
+                {
+                    return ( aPoints[aB] - aPoints[aA] ).Cross( aPoints[aC] - aPoints[aA] ) > 0;
+                };
+
+        // Monotone chain: lower hull, then upper hull
+        for( int i = 0; i < n; i++ )
+        {
+            while( k >= 2 && !turnsLeft( hull[k - 2], hull[k - 1], i ) )
+                k--;
+
+            hull[k++] = i;
+        }
+
+        for( int i = n - 2, lower = k + 1; i >= 0; i-- )
+        {
+            while( k >= lower && !turnsLeft( hull[k - 2], hull[k - 1], i ) )
+                k--;
+
+            hull[k++] = i;
+        }
+
+        hull.resize( k - 1 );   // the last point is the first one
+        return hull;
+    }
+
+    /**
+     * Update the stored triangulation to the new set of points by retriangulating only the
+     * region affected by the added and removed points.
+     *
+     * Every triangle that has a removed vertex or whose circumcircle contains an added point
+     * is discarded.  The remaining triangles are still Delaunay, and the Delaunay triangles
+     * of the new point set that replace the discarded ones only use the surviving vertices of
+     * the discarded triangles and the added points.  Triangulating that subset therefore gives
+     * a superset of the missing triangles, which is all the spanning tree needs.
+     *
+     * This only holds within the convex hull of the old points: the triangulation has no
+     * triangles outside of it to discard, so the hull must not change.
+     *
+     * @return false if the triangulation has to be rebuilt from scratch.
+     */
+    bool repair( const std::vector<VECTOR2I>& aNewPoints )
+    {
+        if( m_triangles.empty() )
+            return false;
+
+        // Match the old and the new points; both are sorted the same way
+        std::vector<int> oldToNew( m_points.size(), -1 );
+        std::vector<int> added;
+        size_t           removedCount = 0;
+
+        auto less =
+                []( const VECTOR2I& a, const VECTOR2I& b )
+                {
+                    return a.x < b.x || ( a.x == b.x && a.y < b.y );
+                };
+
+        for( size_t i = 0, j = 0; i < m_points.size() || j < aNewPoints.size(); )
+        {
+            if( j == aNewPoints.size() || ( i < m_points.size() && less( m_points[i], aNewPoints[j] ) ) )
+            {
+                removedCount++;
+                i++;
+            }
+            else if( i == m_points.size() || less( aNewPoints[j], m_points[i] ) )
+            {
+                added.push_back( j++ );
+            }
+            else
+            {
+                oldToNew[i++] = j++;
+            }
+        }
+
+        if( ( removedCount + added.size() ) * MAX_CHANGED_FRACTION > aNewPoints.size() )
+            return false;
+
+        // Removing a hull vertex or adding a point outside the hull changes the hull
+        std::vector<int> hull = convexHull( m_points );
+
+        if( hull.size() < 3 )
+            return false;
+
+        for( int idx : hull )
+        {
+            if( oldToNew[idx] < 0 )
+                return false;
+        }
+
+        for( int idx : added )
+        {
+            const VECTOR2I& p = aNewPoints[idx];
+
+            for( size_t i = 0; i < hull.size(); i++ )
+            {
+                const VECTOR2I& a = m_points[hull[i]];
+                const VECTOR2I& b = m_points[hull[( i + 1 ) % hull.size()]];
+
+                if( ( b - a ).Cross( p - a ) <= 0 )
+                    return false;
+            }
+        }
+
+        BOX2I addedBBox;
+
+        for( size_t i = 0; i < added.size(); i++ )
+        {
+            if( i == 0 )
+                addedBBox = BOX2I( aNewPoints[added[i]], VECTOR2I( 0, 0 ) );
+            else
+                addedBBox.Merge( aNewPoints[added[i]] );
+        }
+
+        std::vector<TRIANGLE> triangles;
+        std::vector<char>     inCavity( aNewPoints.size(), 0 );
+        std::vector<int>      cavityPoints;
+
+        triangles.reserve( m_triangles.size() + 4 * added.size() );
+
+        auto markCavity =
+                [&]( int aIdx )
+                {
+                    if( aIdx >= 0 && !inCavity[aIdx] )
+                    {
+                        inCavity[aIdx] = 1;
+                        cavityPoints.push_back( aIdx );
+                    }
+                };
+
+        for( int idx : added )
+            markCavity( idx );
+
+        for( const TRIANGLE& t : m_triangles )
+        {
+            bool conflict = oldToNew[t.v[0]] < 0 || oldToNew[t.v[1]] < 0 || oldToNew[t.v[2]] < 0;
+
+            if( !conflict && !added.empty() )
+            {
+                double r = std::sqrt( t.radiusSq );
+
+                if( t.center.x + r >= addedBBox.GetLeft() && t.center.x - r <= addedBBox.GetRight()
+                        && t.center.y + r >= addedBBox.GetTop()
+                        && t.center.y - r <= addedBBox.GetBottom() )
+                {
+                    for( int idx : added )
+                    {
+                        if( inCircumcircle( t, aNewPoints[idx] ) )
+                        {
+                            conflict = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if( conflict )
+            {
+                for( int v : t.v )
+                    markCavity( oldToNew[v] );
+            }
+            else
+            {
+                TRIANGLE kept = t;
+
+                for( int& v : kept.v )
+                    v = oldToNew[v];
+
+                triangles.push_back( kept );
+            }
+        }
+
+        // Points that only belonged to discarded triangles must be reconnected as well, but
+        // they are all cavity points, so the local triangulation takes care of them.
+        if( !cavityPoints.empty() && !triangulate( aNewPoints, cavityPoints, triangles ) )
+            return false;
+
+        // Redundant triangles from the local triangulation accumulate over repeated repairs
+        // (a planar triangulation has less than 2n triangles); start afresh once in a while.
+        if( triangles.size() > 3 * aNewPoints.size() )
+            return false;
+
+        m_points = aNewPoints;
+        m_triangles = std::move( triangles );
+        return true;
+    }
+
 public:
 
     void Clear()
@@ -175,11 +479,11 @@ public:
 
     void Triangulate( std::vector<CN_EDGE>& mstEdges )
     {
-        std::vector<double>                                    node_pts;
+        std::vector<VECTOR2I>                                  points;
         std::vector<std::shared_ptr<CN_ANCHOR>>                anchors;
         std::vector< std::vector<std::shared_ptr<CN_ANCHOR>> > anchorChains( m_allNodes.size() );
 
-        node_pts.reserve( 2 * m_allNodes.size() );
+        points.reserve( m_allNodes.size() );
         anchors.reserve( m_allNodes.size() );
 
         auto addEdge =
@@ -194,8 +498,7 @@ public:
         {
             if( !prev || prev->Pos() != n->Pos() )
             {
-                node_pts.push_back( n->Pos().x );
-                node_pts.push_back( n->Pos().y );
+                points.push_back( n->Pos() );
                 anchors.push_back( n );
                 prev = n;
             }
@@ -205,10 +508,13 @@ public:
 
         if( anchors.size() < 2 )
         {
+            m_triangles.clear();
             return;
         }
         else if( areNodesColinear( anchors ) )
         {
+            m_triangles.clear();
+
             // special case: all nodes are on the same line - there's no
             // triangulation for such set. In this case, we sort along any coordinate
             // and chain the nodes together.
@@ -217,22 +523,24 @@ public:
         }
         else
         {
-            delaunator::Delaunator delaunator( node_pts );
-            auto& triangles = delaunator.triangles;
-
-            for( size_t i = 0; i < triangles.size(); i += 3 )
+            // Moving a few items of a large net only changes the triangulation locally
+            if( points != m_points && !repair( points ) )
             {
-                addEdge( anchors[triangles[i]],     anchors[triangles[i + 1]] );
-                addEdge( anchors[triangles[i + 1]], anchors[triangles[i + 2]] );
-                addEdge( anchors[triangles[i + 2]], anchors[triangles[i]]     );
+                std::vector<int> all( points.size() );
+
+                for( size_t i = 0; i < all.size(); i++ )
+                    all[i] = i;
+
+                m_points = points;
+                m_triangles.clear();
+                triangulate( m_points, all, m_triangles );
             }
 
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
+            for( const TRIANGLE& t : m_triangles )
             {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
-                    continue;
-
-                addEdge( anchors[triangles[i]], anchors[triangles[delaunator.halfedges[i]]] );
+                addEdge( anchors[t.v[0]], anchors[t.v[1]] );
+                addEdge( anchors[t.v[1]], anchors[t.v[2]] );
+                addEdge( anchors[t.v[2]], anchors[t.v[0]] );
             }
         }
 
@@ -63,6 +63,16 @@ void INDEX::Remove( ITEM* aItem )
 }
 
 
+void INDEX::Clear()
+{
+    for( ITEM_SHAPE_INDEX& subIndex : m_subIndices )
+        subIndex.RemoveAll();
+
+    m_netMap.clear();
+    m_allItems.clear();
+}
+
+
 void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 {
     Remove( aOldItem );
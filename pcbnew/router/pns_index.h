@@ -61,6 +61,11 @@ public:
      */
     void Remove( ITEM* aItem );
 
+    /**
+     * Removes all items from the index, keeping the allocated subindices for reuse.
+     */
+    void Clear();
+
     /**
      * Replaces one item with another.
      */
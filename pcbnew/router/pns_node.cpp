@@ -20,6 +20,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
 #include <vector>
 #include <cassert>
 #include <utility>
@@ -52,6 +53,9 @@ namespace PNS {
 static std::unordered_set<const NODE*> allocNodes;
 #endif
 
+///< Source of the node revisions, shared by all the nodes so that revisions are unique.
+static std::atomic<uint64_t> s_lastRevision( 0 );
+
 NODE::NODE()
 {
     m_depth = 0;
@@ -60,6 +64,9 @@ NODE::NODE()
     m_maxClearance = 800000;    // fixme: depends on how thick traces are.
     m_ruleResolver = nullptr;
     m_index = new INDEX;
+    m_queryCount = 0;
+    m_revision = ++s_lastRevision;
+    m_scratchDepth = 0;
 
 #ifdef DEBUG
     allocNodes.insert( this );
@@ -87,6 +94,19 @@ NODE::~NODE()
 
     m_joints.clear();
 
+    releaseOwnedHoles();
+    releaseGarbage();
+    unlinkParent();
+
+    for( NODE* node : m_branchPool )
+        delete node;
+
+    delete m_index;
+}
+
+
+void NODE::releaseOwnedHoles()
+{
     std::vector<const ITEM*> toDelete;
 
     toDelete.reserve( m_index->Size() );
@@ -118,11 +138,6 @@ NODE::~NODE()
     {
         m_ruleResolver->ClearCacheForItems( toDelete );
     }
-
-    releaseGarbage();
-    unlinkParent();
-
-    delete m_index;
 }
 
 
@@ -142,15 +157,27 @@ int NODE::GetClearance( const ITEM* aA, const ITEM* aB, bool aUseClearanceEpsilo
 
 NODE* NODE::Branch()
 {
-    NODE* child = new NODE;
+    NODE* root = isRoot() ? this : m_root;
+    NODE* child = nullptr;
+
+    if( !root->m_branchPool.empty() )
+    {
+        child = root->m_branchPool.back();
+        root->m_branchPool.pop_back();
+    }
+    else
+    {
+        child = new NODE;
+    }
 
     m_children.insert( child );
 
     child->m_depth = m_depth + 1;
     child->m_parent = this;
     child->m_ruleResolver = m_ruleResolver;
-    child->m_root = isRoot() ? this : m_root;
+    child->m_root = root;
     child->m_maxClearance = m_maxClearance;
+    child->m_revision = m_revision;
 
     // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
     // joints, overridden item maps and pointers to stored items.
@@ -176,6 +203,16 @@ NODE* NODE::Branch()
 }
 
 
+void NODE::touchRevision()
+{
+    m_revision = ++s_lastRevision;
+
+    // The branches see the items of this node, so their contents changed as well
+    for( NODE* child : m_children )
+        child->touchRevision();
+}
+
+
 void NODE::unlinkParent()
 {
     if( isRoot() )
@@ -241,7 +278,7 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
         if( !aCandidate->Collide( m_item, m_node, m_ctx ) )
             return true;
 
-        if( m_ctx->options.m_limitCount > 0 && m_ctx->obstacles.size() >= m_ctx->options.m_limitCount )
+        if( m_ctx->options.m_limitCount > 0 && m_ctx->ObstacleCount() >= m_ctx->options.m_limitCount )
             return false;
 
         return true;
@@ -249,16 +286,68 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 };
 
 
+/**
+ * An obstacle list borrowed from the node for the duration of a search.
+ *
+ * Each level of nested searches (e.g. a search run while walking the results of another one)
+ * gets its own list, so the results of the outer search are never overwritten.  The lists keep
+ * their storage, so the searches don't allocate once the node has been used for a while.
+ */
+class NODE::SCRATCH_OBSTACLES
+{
+public:
+    SCRATCH_OBSTACLES( const NODE* aNode ) :
+            m_node( aNode )
+    {
+        if( m_node->m_scratchDepth == m_node->m_scratchObstacles.size() )
+            m_node->m_scratchObstacles.push_back( std::make_unique<OBSTACLE_LIST>() );
+
+        m_list = m_node->m_scratchObstacles[m_node->m_scratchDepth++].get();
+        m_list->Clear();
+    }
+
+    ~SCRATCH_OBSTACLES()
+    {
+        m_node->m_scratchDepth--;
+    }
+
+    OBSTACLE_LIST& operator*() { return *m_list; }
+
+private:
+    const NODE*    m_node;
+    OBSTACLE_LIST* m_list;
+};
+
+
 int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
                           const COLLISION_SEARCH_OPTIONS& aOpts ) const
 {
     COLLISION_SEARCH_CONTEXT ctx( aObstacles, aOpts );
 
+    return queryColliding( aItem, ctx );
+}
+
+
+int NODE::QueryColliding( const ITEM* aItem, OBSTACLE_LIST& aObstacles,
+                          const COLLISION_SEARCH_OPTIONS& aOpts ) const
+{
+    COLLISION_SEARCH_CONTEXT ctx( aObstacles, aOpts );
+
+    return queryColliding( aItem, ctx );
+}
+
+
+int NODE::queryColliding( const ITEM* aItem, COLLISION_SEARCH_CONTEXT& aCtx ) const
+{
+    const COLLISION_SEARCH_OPTIONS& opts = aCtx.options;
+
+    m_root->m_queryCount++;
+
     /// By default, virtual items cannot collide
     if( aItem->IsVirtual() )
         return 0;
 
-    DEFAULT_OBSTACLE_VISITOR visitor( &ctx, aItem );
+    DEFAULT_OBSTACLE_VISITOR visitor( &aCtx, aItem );
 
 #ifdef DEBUG
     assert( allocNodes.find( this ) != allocNodes.end() );
@@ -270,13 +359,13 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
     m_index->Query( aItem, m_maxClearance, visitor );
 
     // if we haven't found enough items, look in the root branch as well.
-    if( !isRoot() && ( ctx.obstacles.size() < aOpts.m_limitCount || aOpts.m_limitCount < 0 ) )
+    if( !isRoot() && ( aCtx.ObstacleCount() < opts.m_limitCount || opts.m_limitCount < 0 ) )
     {
         visitor.SetWorld( m_root, this );
         m_root->m_index->Query( aItem, m_maxClearance, visitor );
     }
 
-    return aObstacles.size();
+    return aCtx.ObstacleCount();
 }
 
 
@@ -285,7 +374,8 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
 {
     DIRECTION_45::CORNER_MODE cornerMode = ROUTER::GetInstance()->Settings().GetCornerMode();
     const int                 clearanceEpsilon = GetRuleResolver()->ClearanceEpsilon();
-    OBSTACLES                 obstacleList;
+    SCRATCH_OBSTACLES         scratch( this );
+    OBSTACLE_LIST&            obstacleList = *scratch;
 
     for( int i = 0; i < aLine->CLine().SegmentCount(); i++ )
     {
@@ -300,7 +390,7 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
     if( aLine->EndsWithVia() )
         QueryColliding( &aLine->Via(), obstacleList, aOpts );
 
-    if( obstacleList.empty() )
+    if( obstacleList.Empty() )
         return OPT_OBSTACLE();
 
     OBSTACLE nearest;
@@ -387,7 +477,7 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
     }
 
     if( nearest.m_distFirst == INT_MAX )
-        nearest = (*obstacleList.begin());
+        nearest = obstacleList.Front();
 
     return nearest;
 }
@@ -419,7 +509,8 @@ NODE::OPT_OBSTACLE NODE::CheckColliding( const ITEM* aItemA, int aKindMask )
 
 NODE::OPT_OBSTACLE NODE::CheckColliding( const ITEM* aItemA, const COLLISION_SEARCH_OPTIONS& aOpts )
 {
-    OBSTACLES obs;
+    SCRATCH_OBSTACLES scratch( this );
+    OBSTACLE_LIST&    obs = *scratch;
 
     if( aItemA->Kind() == ITEM::LINE_T )
     {
@@ -437,7 +528,7 @@ NODE::OPT_OBSTACLE NODE::CheckColliding( const ITEM* aItemA, const COLLISION_SEA
             n += QueryColliding( &s, obs, aOpts );
 
             if( n )
-                return OPT_OBSTACLE( *obs.begin() );
+                return OPT_OBSTACLE( obs.Front() );
         }
 
         if( line->EndsWithVia() )
@@ -445,12 +536,12 @@ NODE::OPT_OBSTACLE NODE::CheckColliding( const ITEM* aItemA, const COLLISION_SEA
             n += QueryColliding( &line->Via(), obs, aOpts );
 
             if( n )
-                return OPT_OBSTACLE( *obs.begin() );
+                return OPT_OBSTACLE( obs.Front() );
         }
     }
     else if( QueryColliding( aItemA, obs, aOpts ) > 0 )
     {
-        return OPT_OBSTACLE( *obs.begin() );
+        return OPT_OBSTACLE( obs.Front() );
     }
 
     return OPT_OBSTACLE();
@@ -528,6 +619,7 @@ void NODE::addSolid( SOLID* aSolid )
 
     aSolid->SetOwner( this );
     m_index->Add( aSolid );
+    touchRevision();
 }
 
 
@@ -553,6 +645,7 @@ void NODE::addVia( VIA* aVia )
     aVia->SetOwner( this );
 
     m_index->Add( aVia );
+    touchRevision();
 }
 
 
@@ -563,6 +656,7 @@ void NODE::addHole( HOLE* aHole )
 
     aHole->SetOwner( this );
     m_index->Add( aHole );
+    touchRevision();
 }
 
 
@@ -657,6 +751,7 @@ void NODE::addSegment( SEGMENT* aSeg )
     linkJoint( aSeg->Seg().B, aSeg->Layers(), aSeg->Net(), aSeg );
 
     m_index->Add( aSeg );
+    touchRevision();
 }
 
 
@@ -686,6 +781,7 @@ void NODE::addArc( ARC* aArc )
     linkJoint( aArc->Anchor( 1 ), aArc->Layers(), aArc->Net(), aArc );
 
     m_index->Add( aArc );
+    touchRevision();
 }
 
 
@@ -707,6 +803,7 @@ bool NODE::Add( std::unique_ptr< ARC > aArc, bool aAllowRedundant )
 void NODE::AddEdgeExclusion( std::unique_ptr<SHAPE> aShape )
 {
     m_edgeExclusions.push_back( std::move( aShape ) );
+    touchRevision();
 }
 
 
@@ -724,6 +821,8 @@ bool NODE::QueryEdgeExclusions( const VECTOR2I& aPos ) const
 
 void NODE::doRemove( ITEM* aItem )
 {
+    touchRevision();
+
     // case 1: removing an item that is stored in the root node from any branch:
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
@@ -1246,6 +1345,7 @@ void NODE::LockJoint( const VECTOR2I& aPos, const ITEM* aItem, bool aLock )
 {
     JOINT& jt = touchJoint( aPos, aItem->Layers(), aItem->Net() );
     jt.Lock( aLock );
+    touchRevision();
 }
 
 
@@ -1443,8 +1543,40 @@ void NODE::releaseChildren()
     for( NODE* node : kids )
     {
         node->releaseChildren();
-        delete node;
+        m_root->recycleBranch( node );
+    }
+}
+
+
+void NODE::recycleBranch( NODE* aNode )
+{
+    if( m_branchPool.size() >= BRANCH_POOL_SIZE )
+    {
+        delete aNode;
+        return;
     }
+
+    aNode->clearBranch();
+    m_branchPool.push_back( aNode );
+}
+
+
+void NODE::clearBranch()
+{
+    // Same as the destructor, but keep the containers (and their allocated storage) around
+    m_joints.clear();
+
+    releaseOwnedHoles();
+    unlinkParent();
+
+    m_index->Clear();
+    m_override.clear();
+    m_edgeExclusions.clear();
+
+    m_parent = nullptr;
+    m_root = this;
+    m_depth = 0;
+    m_ruleResolver = nullptr;
 }
 
 
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <set>
 #include <core/minoptmax.h>
 
@@ -120,15 +121,79 @@ struct COLLISION_SEARCH_OPTIONS
 };
 
 
+/**
+ * Obstacles found by collision searches, in the order they were found and without duplicate
+ * head/item pairs.
+ *
+ * A search rarely finds more than a few obstacles, so duplicates are looked for linearly and
+ * a cleared list keeps its storage for the next search.
+ */
+class OBSTACLE_LIST
+{
+public:
+    typedef std::vector<OBSTACLE>::const_iterator const_iterator;
+
+    ///< Add an obstacle unless the same head/item pair has been found already.
+    void Add( const OBSTACLE& aObstacle )
+    {
+        for( const OBSTACLE& obstacle : m_obstacles )
+        {
+            if( obstacle == aObstacle )
+                return;
+        }
+
+        m_obstacles.push_back( aObstacle );
+    }
+
+    void Clear() { m_obstacles.clear(); }
+
+    size_t Size() const { return m_obstacles.size(); }
+    bool Empty() const { return m_obstacles.empty(); }
+    const OBSTACLE& Front() const { return m_obstacles.front(); }
+
+    const_iterator begin() const { return m_obstacles.begin(); }
+    const_iterator end() const { return m_obstacles.end(); }
+
+private:
+    std::vector<OBSTACLE> m_obstacles;
+};
+
+
+/**
+ * Where a collision search stores the obstacles it finds: either an #OBSTACLE_LIST or a
+ * std::set of obstacles.
+ */
 struct COLLISION_SEARCH_CONTEXT
 {
+    COLLISION_SEARCH_CONTEXT( OBSTACLE_LIST& aObs, const COLLISION_SEARCH_OPTIONS aOpts ) :
+        obstacleList( &aObs ),
+        obstacleSet( nullptr ),
+        options( aOpts )
+    {
+    }
+
     COLLISION_SEARCH_CONTEXT( std::set<OBSTACLE>& aObs, const COLLISION_SEARCH_OPTIONS aOpts ) :
-        obstacles( aObs ),
+        obstacleList( nullptr ),
+        obstacleSet( &aObs ),
         options( aOpts )
     {
     }
 
-    std::set<OBSTACLE>& obstacles;
+    void AddObstacle( const OBSTACLE& aObstacle )
+    {
+        if( obstacleList )
+            obstacleList->Add( aObstacle );
+        else
+            obstacleSet->insert( aObstacle );
+    }
+
+    size_t ObstacleCount() const
+    {
+        return obstacleList ? obstacleList->Size() : obstacleSet->size();
+    }
+
+    OBSTACLE_LIST*                 obstacleList;
+    std::set<OBSTACLE>*            obstacleSet;
     const COLLISION_SEARCH_OPTIONS options;
 };
 
@@ -271,6 +336,35 @@ public:
     int QueryColliding( const ITEM* aItem, OBSTACLES& aObstacles,
                         const COLLISION_SEARCH_OPTIONS& aOpts = COLLISION_SEARCH_OPTIONS() ) const;
 
+    /**
+     * Find items colliding (closer than clearance) with the item \a aItem, appending them to
+     * \a aObstacles in the order they are found.  Obstacles already present in \a aObstacles
+     * are not added again, so a list can collect the obstacles of several items (e.g. one call
+     * per line segment).
+     *
+     * @return total number of obstacles in \a aObstacles.
+     */
+    int QueryColliding( const ITEM* aItem, OBSTACLE_LIST& aObstacles,
+                        const COLLISION_SEARCH_OPTIONS& aOpts = COLLISION_SEARCH_OPTIONS() ) const;
+
+    /**
+     * @return the number of collision queries run on the root node and all of its branches
+     *         since the last call to ResetQueryCount().  Used for profiling.
+     */
+    uint64_t QueryCount() const { return m_root->m_queryCount; }
+
+    void ResetQueryCount() { m_root->m_queryCount = 0; }
+
+    /**
+     * Return the revision of the contents of this node (including the parent branches).
+     *
+     * Revisions are unique across all the nodes: any change to the node or to one of its
+     * parents assigns it a new one, while a freshly created branch inherits the revision of its
+     * parent, as it has the same contents.  Two nodes reporting the same revision hold the same
+     * set of items.
+     */
+    uint64_t Revision() const { return m_revision; }
+
     int QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints,
                      PNS_LAYER_RANGE aLayerMask = PNS_LAYER_RANGE::All(), int aKindMask = ITEM::ANY_T );
 
@@ -372,6 +466,8 @@ public:
      * items) wrs to the root.
      *
      * @note If there are any branches in use, their parents must **not** be deleted.
+     * @note Branches released by KillChildren() or Commit() are recycled by the root node, so
+     *       pointers to them must not be kept around.
      *
      * @return the new branch.
      */
@@ -508,8 +604,16 @@ private:
     void unlinkParent();
     void releaseChildren();
     void releaseGarbage();
+    void releaseOwnedHoles();
+    void touchRevision();
+    void recycleBranch( NODE* aNode );
+    void clearBranch();
     void rebuildJoint( const JOINT* aJoint, const ITEM* aItem );
 
+    int queryColliding( const ITEM* aItem, COLLISION_SEARCH_CONTEXT& aCtx ) const;
+
+    class SCRATCH_OBSTACLES;
+
     bool isRoot() const
     {
         return m_parent == nullptr;
@@ -552,6 +656,20 @@ private:
     std::vector< std::unique_ptr<SHAPE> > m_edgeExclusions;
 
     std::unordered_set<ITEM*> m_garbageItems;
+
+    ///< Killed branches kept by the root node for reuse by Branch(), so that their hash tables
+    ///< and spatial subindices don't have to be reallocated on every mouse move.
+    std::vector<NODE*> m_branchPool;
+
+    mutable uint64_t   m_queryCount;        ///< collision queries, counted in the root node only
+    uint64_t           m_revision;          ///< see Revision()
+
+    ///< Obstacle lists reused by the searches of this node, one per level of nested searches
+    ///< (see SCRATCH_OBSTACLES).
+    mutable std::vector<std::unique_ptr<OBSTACLE_LIST>> m_scratchObstacles;
+    mutable size_t                                      m_scratchDepth;
+
+    static constexpr size_t BRANCH_POOL_SIZE = 64;
 };
 
 }
@@ -24,6 +24,7 @@
 #include <geometry/shape_simple.h>
 
 #include <cmath>
+#include <mutex>
 
 #include "pns_arc.h"
 #include "pns_line.h"
@@ -109,6 +110,116 @@ bool COST_ESTIMATOR::IsBetter( const COST_ESTIMATOR& aOther, double aLengthToler
 }
 
 
+/**
+ * Memo of the most recent OPTIMIZER::Optimize() results for single lines.
+ *
+ * While the cursor moves within one grid cell, the interactive router keeps asking the
+ * optimizer to process the very same line in the very same world.  Results are keyed by the
+ * revision of the world (see NODE::Revision()), the optimizer settings and the input vertices,
+ * so any change to the world or to the line is a cache miss.
+ */
+class OPTIMIZER_RESULT_CACHE
+{
+public:
+    struct KEY
+    {
+        uint64_t              m_worldRevision = 0;
+        int                   m_effortLevel = 0;
+        int                   m_collisionMask = 0;
+        int                   m_cornerMode = 0;
+        VECTOR2I              m_preservedVertex;
+        std::pair<int, int>   m_vertexRange;
+        BOX2I                 m_restrictArea;
+        bool                  m_restrictAreaIsStrict = false;
+        int                   m_width = 0;
+        PNS_LAYER_RANGE       m_layers;
+        NET_HANDLE            m_net = nullptr;
+        bool                  m_hasVia = false;
+        VECTOR2I              m_viaPos;
+        int                   m_viaDiameter = 0;
+        int                   m_viaDrill = 0;
+        bool                  m_closed = false;
+        std::vector<VECTOR2I> m_points;
+
+        bool operator==( const KEY& aOther ) const
+        {
+            // Cheapest and most likely to differ first
+            return m_worldRevision == aOther.m_worldRevision
+                   && m_points.size() == aOther.m_points.size()
+                   && m_effortLevel == aOther.m_effortLevel
+                   && m_collisionMask == aOther.m_collisionMask
+                   && m_cornerMode == aOther.m_cornerMode
+                   && m_preservedVertex == aOther.m_preservedVertex
+                   && m_vertexRange == aOther.m_vertexRange
+                   && m_restrictArea == aOther.m_restrictArea
+                   && m_restrictAreaIsStrict == aOther.m_restrictAreaIsStrict
+                   && m_width == aOther.m_width
+                   && m_layers == aOther.m_layers
+                   && m_net == aOther.m_net
+                   && m_hasVia == aOther.m_hasVia
+                   && m_viaPos == aOther.m_viaPos
+                   && m_viaDiameter == aOther.m_viaDiameter
+                   && m_viaDrill == aOther.m_viaDrill
+                   && m_closed == aOther.m_closed
+                   && m_points == aOther.m_points;
+        }
+    };
+
+    static OPTIMIZER_RESULT_CACHE& Instance()
+    {
+        static OPTIMIZER_RESULT_CACHE cache;
+        return cache;
+    }
+
+    bool Find( const KEY& aKey, SHAPE_LINE_CHAIN& aResult, bool& aOptimized )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        for( const ENTRY& entry : m_entries )
+        {
+            if( entry.m_key == aKey )
+            {
+                aResult = entry.m_result;
+                aOptimized = entry.m_optimized;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Store( KEY&& aKey, const SHAPE_LINE_CHAIN& aResult, bool aOptimized )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_entries.size() < MAX_ENTRIES )
+            m_entries.emplace_back();
+
+        // Once full, overwrite the oldest entry
+        ENTRY& entry = m_entries[m_next];
+        m_next = ( m_next + 1 ) % MAX_ENTRIES;
+
+        entry.m_key = std::move( aKey );
+        entry.m_result = aResult;
+        entry.m_optimized = aOptimized;
+    }
+
+private:
+    struct ENTRY
+    {
+        KEY              m_key;
+        SHAPE_LINE_CHAIN m_result;
+        bool             m_optimized = false;
+    };
+
+    static constexpr size_t MAX_ENTRIES = 16;
+
+    std::vector<ENTRY> m_entries;
+    size_t             m_next = 0;
+    std::mutex         m_mutex;
+};
+
+
 OPTIMIZER::OPTIMIZER( NODE* aWorld ) :
     m_world( aWorld ),
     m_collisionKindMask( ITEM::ANY_T ),
@@ -618,6 +729,48 @@ bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
     bool hasArcs = aLine->ArcCount();
     bool rv = false;
 
+    // Results depending on the root line (corner count limit) or on constraints left over from
+    // a previous run of this optimizer are not part of the cache key, so don't memoize them.
+    bool useCache = m_world && !hasArcs && m_constraints.empty()
+                    && !( ( m_effortLevel & LIMIT_CORNER_COUNT ) && aRoot );
+
+    OPTIMIZER_RESULT_CACHE::KEY cacheKey;
+
+    if( useCache )
+    {
+        cacheKey.m_worldRevision = m_world->Revision();
+        cacheKey.m_effortLevel = m_effortLevel;
+        cacheKey.m_collisionMask = m_collisionKindMask;
+        cacheKey.m_cornerMode = ROUTER::GetInstance()->Settings().GetCornerMode();
+        cacheKey.m_preservedVertex = m_preservedVertex;
+        cacheKey.m_vertexRange = m_restrictedVertexRange;
+        cacheKey.m_restrictArea = m_restrictArea;
+        cacheKey.m_restrictAreaIsStrict = m_restrictAreaIsStrict;
+        cacheKey.m_width = aResult->Width();
+        cacheKey.m_layers = aResult->Layers();
+        cacheKey.m_net = aResult->Net();
+        cacheKey.m_closed = aResult->CLine().IsClosed();
+        cacheKey.m_points = aResult->CLine().CPoints();
+
+        if( aResult->EndsWithVia() )
+        {
+            cacheKey.m_hasVia = true;
+            cacheKey.m_viaPos = aResult->Via().Pos();
+            cacheKey.m_viaDiameter = aResult->Via().Diameter();
+            cacheKey.m_viaDrill = aResult->Via().Drill();
+        }
+
+        SHAPE_LINE_CHAIN cached;
+
+        if( OPTIMIZER_RESULT_CACHE::Instance().Find( cacheKey, cached, rv ) )
+        {
+            if( rv )
+                aResult->SetShape( cached );
+
+            return rv;
+        }
+    }
+
     if( (m_effortLevel & LIMIT_CORNER_COUNT) && aRoot )
     {
         const int angleMask = DIRECTION_45::ANG_OBTUSE;
@@ -677,6 +830,9 @@ bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
     if( !hasArcs && m_effortLevel & FANOUT_CLEANUP )
         rv |= fanoutCleanup( aResult );
 
+    if( useCache )
+        OPTIMIZER_RESULT_CACHE::Instance().Store( std::move( cacheKey ), aResult->CLine(), rv );
+
     return rv;
 }
 
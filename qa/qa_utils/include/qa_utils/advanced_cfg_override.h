@@ -0,0 +1,62 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef QA_ADVANCED_CFG_OVERRIDE__H
+#define QA_ADVANCED_CFG_OVERRIDE__H
+
+#include <advanced_config.h>
+
+namespace KI_TEST
+{
+
+/**
+ * Give an advanced config setting another value for the lifetime of the object.
+ *
+ * The advanced config is meant to be read only, so this is for tests only.  For example:
+ *
+ *     KI_TEST::ADVANCED_CFG_OVERRIDE<int> cacheSize( &ADVANCED_CFG::m_FootprintCacheSize, 2 );
+ */
+template <typename T>
+class ADVANCED_CFG_OVERRIDE
+{
+public:
+    ADVANCED_CFG_OVERRIDE( T ADVANCED_CFG::*aSetting, const T& aValue ) :
+            m_setting( const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() ).*aSetting ),
+            m_previous( m_setting )
+    {
+        m_setting = aValue;
+    }
+
+    ~ADVANCED_CFG_OVERRIDE() { m_setting = m_previous; }
+
+    ADVANCED_CFG_OVERRIDE( const ADVANCED_CFG_OVERRIDE& ) = delete;
+    ADVANCED_CFG_OVERRIDE& operator=( const ADVANCED_CFG_OVERRIDE& ) = delete;
+
+private:
+    T& m_setting;
+    T  m_previous;
+};
+
+} // namespace KI_TEST
+
+#endif // QA_ADVANCED_CFG_OVERRIDE__H
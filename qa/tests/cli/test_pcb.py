@@ -139,3 +139,43 @@ def test_pcb_export_gerber( kitest: KiTestFixture,
         # Comparison DPI = 5080 => 1px == 5um. I.e. allowable error of 15 um after eroding
         assert utils.gerbers_are_equivalent( str( generated_gerber_path ), gbr_source_path, 5080,
                                              originInches, windowsizeInches )
+
+
+def test_pcb_batch_define_var( kitest: KiTestFixture ):
+    output_dir = kitest.get_output_path( "cli/batch_define_var/" )
+    source_dir = Path( kitest.get_data_file_path( "cli/basic_test" ) )
+    board_path = output_dir / "basic_test.kicad_pcb"
+
+    # A copy of the basic test board showing a project variable
+    board = ( source_dir / "basic_test.kicad_pcb" ).read_text()
+    board_path.write_text( board.replace( "AWESOME LPF", "BATCH-${BATCH_TEST_VAR}" ) )
+    ( output_dir / "basic_test.kicad_pro" ).write_text(
+            ( source_dir / "basic_test.kicad_pro" ).read_text() )
+
+    first_svg = output_dir / "first.svg"
+    second_svg = output_dir / "second.svg"
+
+    for path in ( first_svg, second_svg ):
+        if path.exists():
+            path.unlink()
+
+    # Only the first command defines the variable
+    jobs_path = output_dir / "jobs.txt"
+    jobs_path.write_text(
+            "export svg --layers F.SilkS --exclude-drawing-sheet -D BATCH_TEST_VAR=FIRSTVALUE "
+            "-o \"{}\"\n".format( first_svg.as_posix() ) +
+            "export svg --layers F.SilkS --exclude-drawing-sheet "
+            "-o \"{}\"\n".format( second_svg.as_posix() ) )
+
+    command = ["kicad-cli", "pcb", "batch", "--jobs", str( jobs_path ), str( board_path )]
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+
+    assert exitcode == 0
+    assert first_svg.exists()
+    assert second_svg.exists()
+
+    kitest.add_attachment( first_svg )
+    kitest.add_attachment( second_svg )
+
+    assert "BATCH-FIRSTVALUE" in first_svg.read_text()
+    assert "FIRSTVALUE" not in second_svg.read_text()
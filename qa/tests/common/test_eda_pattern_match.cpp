@@ -0,0 +1,94 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <eda_pattern_match.h>
+
+
+BOOST_AUTO_TEST_SUITE( EdaPatternMatch )
+
+
+static std::vector<SEARCH_TERM> makeTerms()
+{
+    return { SEARCH_TERM( wxT( "LM358" ), 8 ),
+             SEARCH_TERM( wxT( "Amplifier_Operational" ), 4 ),
+             SEARCH_TERM( wxT( "  Low-Power, Dual Operational Amplifiers, DIP-8/SOIC-8  " ), 1 ),
+             SEARCH_TERM( wxT( "dual opamp" ), 1 ),
+             SEARCH_TERM( wxT( "Ω résistance" ), 1 ),
+             SEARCH_TERM( wxT( "pins:8" ), 1 ) };
+}
+
+
+BOOST_AUTO_TEST_CASE( PreparedTermsScoreAsUnprepared )
+{
+    const std::vector<wxString> patterns = {
+        wxT( "lm358" ), wxT( "lm" ),      wxT( "358" ),      wxT( "dual" ),   wxT( "amplifier" ),
+        wxT( "dip-8/soic" ), wxT( "op" ), wxT( "opamps" ),   wxT( "xyz" ),    wxT( "lm*8" ),
+        wxT( "lm3?8" ),  wxT( "/^lm3/" ), wxT( "pins>4" ),   wxT( "pins<4" ), wxT( "ω r" ),
+        wxT( "résist" ), wxT( "^lm358$" ), wxT( "8" ),       wxT( "power," )
+    };
+
+    for( const wxString& pattern : patterns )
+    {
+        BOOST_TEST_CONTEXT( "Pattern " << pattern )
+        {
+            std::vector<SEARCH_TERM> plainTerms = makeTerms();
+            std::vector<SEARCH_TERM> preparedTerms = makeTerms();
+            PREPARED_SEARCH_TERMS    prepared;
+
+            prepared.Prepare( preparedTerms );
+
+            EDA_COMBINED_MATCHER matcher( pattern, CTX_LIBITEM );
+
+            BOOST_CHECK_EQUAL( matcher.ScoreTerms( preparedTerms, prepared ),
+                               matcher.ScoreTerms( plainTerms ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( TrigramsRuleOutMissingSubstrings )
+{
+    std::vector<SEARCH_TERM> terms = makeTerms();
+    PREPARED_SEARCH_TERMS    prepared;
+
+    prepared.Prepare( terms );
+
+    for( const wxString& text : { wxT( "lm358" ), wxT( "operational" ), wxT( "soic-8" ) } )
+    {
+        PREPARED_SEARCH_TERMS::TRIGRAM_BITS bits = {};
+        std::u32string                      text32;
+
+        for( wxUniChar c : text )
+            text32.push_back( static_cast<char32_t>( c.GetValue() ) );
+
+        PREPARED_SEARCH_TERMS::AddTrigrams( text32, bits );
+
+        for( size_t i = 0; i < bits.size(); ++i )
+            BOOST_CHECK_EQUAL( prepared.Trigrams[i] & bits[i], bits[i] );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <view/view_frame_stats.h>
+
+
+using namespace KIGFX;
+
+
+BOOST_AUTO_TEST_SUITE( ViewFrameStats )
+
+
+static void recordFrame( VIEW_FRAME_STATS& aStats, unsigned aItems )
+{
+    GAL_DRAW_STATS galStats;
+    galStats.drawCalls = 1;
+    galStats.vertices = aItems * 6;
+
+    aStats.BeginFrame();
+    aStats.AddLayer( 0, aItems, 1.0 );
+    aStats.SetRedrawTime( 2.0 );
+    aStats.EndFrame( galStats );
+}
+
+
+/**
+ * Nothing is recorded unless the statistics are enabled
+ */
+BOOST_AUTO_TEST_CASE( Disabled )
+{
+    VIEW_FRAME_STATS stats( 4 );
+
+    recordFrame( stats, 10 );
+
+    BOOST_CHECK( !stats.IsRecording() );
+    BOOST_CHECK_EQUAL( stats.GetCount(), 0 );
+}
+
+
+/**
+ * The oldest frames are dropped once the ring buffer is full
+ */
+BOOST_AUTO_TEST_CASE( RingBuffer )
+{
+    VIEW_FRAME_STATS stats( 4 );
+    stats.SetEnabled( true );
+
+    for( unsigned i = 0; i < 6; i++ )
+        recordFrame( stats, i );
+
+    BOOST_REQUIRE_EQUAL( stats.GetCount(), 4 );
+
+    for( size_t i = 0; i < stats.GetCount(); i++ )
+    {
+        const VIEW_FRAME_RECORD& rec = stats.GetFrame( i );
+
+        BOOST_CHECK_EQUAL( rec.frame, i + 2 );
+        BOOST_CHECK_EQUAL( rec.TotalItems(), i + 2 );
+        BOOST_CHECK_EQUAL( rec.gal.vertices, ( i + 2 ) * 6 );
+        BOOST_CHECK_CLOSE( rec.redrawMs, 2.0, 0.01 );
+    }
+
+    stats.Clear();
+    BOOST_CHECK_EQUAL( stats.GetCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -116,6 +116,7 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, INCREMENTAL_NETLIST_TEST_FIXTURE )
                         continue;
 
                     wxString netname = connection->GetNetName();
+                    int      netcode = connection->NetCode();
 
                     if( !item->IsConnectable() )
                         continue;
@@ -146,6 +147,13 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, INCREMENTAL_NETLIST_TEST_FIXTURE )
                     new_graph.Recalculate( sheets, false );
                     m_schematic->ConnectionGraph()->Merge( new_graph );
 
+                    // Net codes must survive the incremental update
+                    if( SCH_CONNECTION* newConnection = item->Connection();
+                        newConnection && newConnection->GetNetName() == netname )
+                    {
+                        BOOST_CHECK_EQUAL( newConnection->NetCode(), netcode );
+                    }
+
                     SCH_ITEM_VEC curr_items = item->ConnectedItems( path );
                     std::sort( curr_items.begin(), curr_items.end() );
                     alg::remove_duplicates( curr_items );
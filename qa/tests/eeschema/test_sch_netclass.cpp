@@ -20,6 +20,8 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include "eeschema_test_utils.h"
 
+#include <connection_graph.h>
+#include <core/thread_pool.h>
 #include <sch_sheet_path.h>
 #include <sch_label.h>
 #include <project/net_settings.h>
@@ -83,4 +85,55 @@ BOOST_AUTO_TEST_CASE( TestMultiNetclasses )
     BOOST_CHECK_EQUAL( nc->GetVariableSubstitutionName(), "CLASS_COMPLETE,CLASS3,CLASS4" );
 }
 
+BOOST_AUTO_TEST_CASE( TestConcurrentNetclassCache )
+{
+    LoadSchematic( "multinetclasses" );
+
+    std::shared_ptr<NET_SETTINGS>& netSettings = m_schematic.Prj().GetProjectFile().m_NetSettings;
+    std::vector<wxString>          netNames;
+
+    for( const auto& [key, subgraphs] : m_schematic.ConnectionGraph()->GetNetMap() )
+        netNames.push_back( key.Name );
+
+    BOOST_REQUIRE( !netNames.empty() );
+
+    // Fill the cache from the thread pool, as the ERC tests do, then resolve each net again
+    // with its cache entry cleared
+    auto checkCache =
+            [&]()
+            {
+                std::vector<std::future<wxString>> returns;
+
+                for( const wxString& netName : netNames )
+                {
+                    returns.emplace_back( GetKiCadThreadPool().submit(
+                            [&netSettings, netName]()
+                            {
+                                return netSettings->GetEffectiveNetClass( netName )
+                                                  ->GetVariableSubstitutionName();
+                            } ) );
+                }
+
+                for( size_t ii = 0; ii < netNames.size(); ++ii )
+                {
+                    wxString cached = returns[ii].get();
+
+                    netSettings->ClearCacheForNet( netNames[ii] );
+
+                    BOOST_CHECK_EQUAL( cached, netSettings->GetEffectiveNetClass( netNames[ii] )
+                                                          ->GetVariableSubstitutionName() );
+                }
+            };
+
+    netSettings->ClearAllCaches();
+    checkCache();
+
+    // Changing the assignments invalidates the cache
+    netSettings->SetNetclassPatternAssignment( wxS( "/NET_*" ), wxS( "CLASS4" ) );
+    checkCache();
+
+    BOOST_CHECK( netSettings->GetEffectiveNetClass( "/NET_1" )
+                            ->GetVariableSubstitutionName().Contains( wxS( "CLASS4" ) ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,169 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test that symbol libraries read in the background, the way SYMBOL_LIB_PRELOADER does, give
+ * the same symbols as libraries loaded when first used.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <core/thread_pool.h>
+#include <lib_symbol.h>
+#include <sch_io/sch_io.h>
+#include <sch_io/sch_io_lib_cache.h>
+#include <symbol_lib_table.h>
+
+#include <algorithm>
+
+#include <wx/filename.h>
+
+
+struct SYMBOL_LIB_PRELOAD_FIXTURE
+{
+    static wxString libraryPath( const wxString& aDir, const wxString& aName )
+    {
+        wxFileName fn( KI_TEST::GetEeschemaTestDataDir() );
+        fn.AppendDir( wxS( "spice_netlists" ) );
+        fn.AppendDir( aDir );
+        fn.SetFullName( aName + wxS( ".kicad_sym" ) );
+
+        return fn.GetFullPath();
+    }
+
+    /**
+     * Read \a aURI on a pool thread, as the preloader does.
+     */
+    static std::unique_ptr<SCH_IO_LIB_CACHE> preload( const wxString& aURI )
+    {
+        std::future<std::unique_ptr<SCH_IO_LIB_CACHE>> ret = GetKiCadThreadPool().submit(
+                [aURI]() -> std::unique_ptr<SCH_IO_LIB_CACHE>
+                {
+                    IO_RELEASER<SCH_IO> plugin( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_KICAD ) );
+
+                    return plugin->ParseLibraryCache( aURI );
+                } );
+
+        return ret.get();
+    }
+
+    static void addLibrary( SYMBOL_LIB_TABLE& aTable, const wxString& aURI )
+    {
+        aTable.InsertRow( new SYMBOL_LIB_TABLE_ROW( wxS( "lib" ), aURI, wxS( "KiCad" ) ) );
+    }
+
+    static void checkSameSymbols( SYMBOL_LIB_TABLE& aTable, SYMBOL_LIB_TABLE& aExpected )
+    {
+        std::vector<LIB_SYMBOL*> symbols;
+        std::vector<LIB_SYMBOL*> expected;
+
+        aTable.LoadSymbolLib( symbols, wxS( "lib" ) );
+        aExpected.LoadSymbolLib( expected, wxS( "lib" ) );
+
+        BOOST_REQUIRE( !expected.empty() );
+        BOOST_REQUIRE_EQUAL( symbols.size(), expected.size() );
+
+        auto byName =
+                []( const LIB_SYMBOL* aLhs, const LIB_SYMBOL* aRhs )
+                {
+                    return aLhs->GetName() < aRhs->GetName();
+                };
+
+        std::sort( symbols.begin(), symbols.end(), byName );
+        std::sort( expected.begin(), expected.end(), byName );
+
+        for( size_t ii = 0; ii < expected.size(); ++ii )
+        {
+            BOOST_TEST_CONTEXT( expected[ii]->GetName() )
+            {
+                BOOST_CHECK_EQUAL( symbols[ii]->GetName(), expected[ii]->GetName() );
+                BOOST_CHECK_EQUAL( symbols[ii]->Compare( *expected[ii] ), 0 );
+            }
+        }
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SymbolLibPreload, SYMBOL_LIB_PRELOAD_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( AdoptedCacheMatchesLoad )
+{
+    wxString                          uri = libraryPath( wxS( "legacy_sallen_key" ),
+                                                         wxS( "sallen_key_schlib" ) );
+    std::unique_ptr<SCH_IO_LIB_CACHE> cache = preload( uri );
+
+    if( !cache )
+    {
+        BOOST_TEST_MESSAGE( "Libraries cannot be read in the background with this compiler" );
+        return;
+    }
+
+    SYMBOL_LIB_TABLE preloaded;
+    SYMBOL_LIB_TABLE loaded;
+
+    addLibrary( preloaded, uri );
+    addLibrary( loaded, uri );
+
+    preloaded.AdoptSymbolLibCache( wxS( "lib" ), uri, SCH_IO_MGR::SCH_KICAD, std::move( cache ) );
+
+    BOOST_CHECK( preloaded.FindRow( wxS( "lib" ), true )->GetIsLoaded() );
+
+    checkSameSymbols( preloaded, loaded );
+}
+
+
+BOOST_AUTO_TEST_CASE( TableChangedDuringPreload )
+{
+    wxString                          oldURI = libraryPath( wxS( "legacy_sallen_key" ),
+                                                            wxS( "sallen_key_schlib" ) );
+    wxString                          newURI = libraryPath( wxS( "legacy_rectifier" ),
+                                                            wxS( "rectifier_schlib" ) );
+    std::unique_ptr<SCH_IO_LIB_CACHE> cache = preload( oldURI );
+
+    if( !cache )
+    {
+        BOOST_TEST_MESSAGE( "Libraries cannot be read in the background with this compiler" );
+        return;
+    }
+
+    SYMBOL_LIB_TABLE preloaded;
+    SYMBOL_LIB_TABLE loaded;
+
+    addLibrary( preloaded, oldURI );
+    addLibrary( loaded, newURI );
+
+    // The library is moved while the old one is being read
+    preloaded.FindRow( wxS( "lib" ), true )->SetFullURI( newURI );
+
+    preloaded.AdoptSymbolLibCache( wxS( "lib" ), oldURI, SCH_IO_MGR::SCH_KICAD,
+                                   std::move( cache ) );
+
+    BOOST_CHECK( !preloaded.FindRow( wxS( "lib" ), true )->GetIsLoaded() );
+
+    checkSameSymbols( preloaded, loaded );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_ipc2581_export.cpp
+ * Test suite for the IPC-2581 exporter
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <pcbnew/pcb_io/ipc2581/pcb_io_ipc2581.h>
+
+#include <board.h>
+#include <settings/settings_manager.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/xml/xml.h>
+
+
+struct IPC2581_EXPORT_FIXTURE
+{
+    IPC2581_EXPORT_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+static std::string readFile( const wxString& aFileName )
+{
+    wxFFile     file( aFileName, wxT( "rb" ) );
+    std::string content;
+
+    BOOST_REQUIRE( file.IsOpened() );
+
+    content.resize( file.Length() );
+    BOOST_REQUIRE_EQUAL( file.Read( content.data(), content.size() ), content.size() );
+
+    return content;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( Ipc2581Export, IPC2581_EXPORT_FIXTURE )
+
+
+/**
+ * The exporter spools finished layers to disk and streams the document through its own
+ * serializer.  Check the result is byte for byte what wxXmlDocument::Save() writes for the
+ * same document.
+ */
+BOOST_AUTO_TEST_CASE( StreamedOutputMatchesXmlDocument )
+{
+    for( const wxString& boardName : { wxT( "complex_hierarchy" ), wxT( "api_kitchen_sink" ) } )
+    {
+        BOOST_TEST_CONTEXT( boardName )
+        {
+            KI_TEST::LoadBoard( m_settingsManager, boardName, m_board );
+
+            wxString                    fileName = wxFileName::CreateTempFileName( wxT( "ipc" ) );
+            std::map<std::string, UTF8> props = { { "units", "mm" }, { "version", "C" } };
+            PCB_IO_IPC2581              exporter;
+
+            exporter.SaveBoard( fileName, m_board.get(), &props );
+
+            std::string streamed = readFile( fileName );
+            wxRemoveFile( fileName );
+
+            BOOST_REQUIRE( !streamed.empty() );
+
+            wxMemoryInputStream input( streamed.data(), streamed.size() );
+            wxXmlDocument       doc;
+
+            BOOST_REQUIRE( doc.Load( input ) );
+            BOOST_CHECK( doc.GetRoot()->GetName() == wxT( "IPC-2581" ) );
+
+            wxMemoryOutputStream output;
+            BOOST_REQUIRE( doc.Save( output ) );
+
+            std::string saved( output.GetLength(), '\0' );
+            output.CopyTo( saved.data(), saved.size() );
+
+            BOOST_CHECK_EQUAL( streamed.size(), saved.size() );
+            BOOST_CHECK( streamed == saved );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,14 +21,21 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <board.h>
 #include <kiid.h>
 #include <footprint.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <pcbnew_utils/board_test_utils.h>
+#include <qa_utils/advanced_cfg_override.h>
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <settings/settings_manager.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
 namespace
 {
 
@@ -98,4 +105,193 @@ BOOST_FIXTURE_TEST_CASE( FootprintLoadSave, FOOTPRINT_LOAD_TEST_FIXTURE )
 
         KI_TEST::LoadAndTestBoardFile( testCase.m_boardFileRelativePath, true, doBoardTest );
     }
-}
\ No newline at end of file
+}
+
+
+BOOST_AUTO_TEST_CASE( FootprintCacheLazyLoad )
+{
+    wxString libPath = KI_TEST::GetPcbnewTestDataDir() + "plugins/eagle/lbr/SparkFun-GPS.pretty";
+    PCB_IO_KICAD_SEXPR pcb_io( CTL_FOR_LIBRARY );
+
+    FP_CACHE eagerCache( &pcb_io, libPath );
+    eagerCache.Load();
+
+    FP_CACHE lazyCache( &pcb_io, libPath );
+    lazyCache.Enumerate();
+
+    BOOST_REQUIRE_EQUAL( lazyCache.GetFootprints().size(), eagerCache.GetFootprints().size() );
+
+    // Nothing is parsed until it is asked for
+    for( const auto& footprint : lazyCache.GetFootprints() )
+        BOOST_CHECK( footprint.second->GetFootprint() == nullptr );
+
+    for( const auto& footprint : eagerCache.GetFootprints() )
+    {
+        const FOOTPRINT* expected = footprint.second->GetFootprint();
+
+        BOOST_TEST_CONTEXT( "Footprint " << footprint.first )
+        {
+            const FOOTPRINT* lazy = lazyCache.GetFootprint( footprint.first );
+
+            BOOST_REQUIRE( lazy );
+            BOOST_CHECK( lazy->GetFPID() == expected->GetFPID() );
+            BOOST_CHECK_EQUAL( lazy->Pads().size(), expected->Pads().size() );
+            BOOST_CHECK( lazyCache.GetFootprint( footprint.first ) == lazy );
+        }
+    }
+
+    BOOST_CHECK( lazyCache.GetFootprint( wxT( "no_such_footprint" ) ) == nullptr );
+}
+
+
+BOOST_AUTO_TEST_CASE( FootprintCacheEviction )
+{
+    KI_TEST::ADVANCED_CFG_OVERRIDE<int> cacheSize( &ADVANCED_CFG::m_FootprintCacheSize, 2 );
+
+    wxString libPath = KI_TEST::GetPcbnewTestDataDir() + "plugins/eagle/lbr/SparkFun-GPS.pretty";
+    PCB_IO_KICAD_SEXPR pcb_io( CTL_FOR_LIBRARY );
+
+    FP_CACHE cache( &pcb_io, libPath );
+    cache.Enumerate();
+
+    std::vector<wxString> names;
+
+    for( const auto& footprint : cache.GetFootprints() )
+        names.push_back( footprint.first );
+
+    BOOST_REQUIRE_GT( names.size(), 4 );
+
+    auto isParsed =
+            [&]( const wxString& aName )
+            {
+                return cache.GetFootprints().find( aName )->second->GetFootprint() != nullptr;
+            };
+
+    // A pinned footprint survives any number of other footprints being read
+    const FOOTPRINT* pinned = cache.GetFootprint( names[0], true );
+    BOOST_REQUIRE( pinned );
+
+    for( size_t ii = 1; ii < names.size(); ++ii )
+        BOOST_CHECK( cache.GetFootprint( names[ii] ) );
+
+    BOOST_CHECK( cache.GetFootprint( names[0] ) == pinned );
+    BOOST_CHECK( pinned->GetFPID().GetLibItemName().wx_str() == names[0] );
+
+    // Only the most recently used unpinned footprints are kept
+    size_t parsed = 0;
+
+    for( size_t ii = 1; ii < names.size(); ++ii )
+    {
+        if( isParsed( names[ii] ) )
+            parsed++;
+    }
+
+    BOOST_CHECK_EQUAL( parsed, 2 );
+    BOOST_CHECK( isParsed( names.back() ) );
+    BOOST_CHECK( !isParsed( names[1] ) );
+
+    // Released footprints are parsed again on demand
+    const FOOTPRINT* reparsed = cache.GetFootprint( names[1] );
+    BOOST_REQUIRE( reparsed );
+    BOOST_CHECK( reparsed->GetFPID().GetLibItemName().wx_str() == names[1] );
+
+    // Pinning a footprint which is already in memory takes it out of the eviction order
+    pinned = cache.GetFootprint( names[1], true );
+    BOOST_CHECK( pinned == reparsed );
+
+    for( size_t ii = 2; ii < names.size(); ++ii )
+        cache.GetFootprint( names[ii] );
+
+    BOOST_CHECK( isParsed( names[1] ) );
+    BOOST_CHECK( cache.GetFootprint( names[1] ) == pinned );
+}
+
+
+BOOST_AUTO_TEST_CASE( FootprintCacheVisitDoesNotPin )
+{
+    KI_TEST::ADVANCED_CFG_OVERRIDE<int> cacheSize( &ADVANCED_CFG::m_FootprintCacheSize, 2 );
+
+    wxString libPath = KI_TEST::GetPcbnewTestDataDir() + "plugins/eagle/lbr/SparkFun-GPS.pretty";
+    PCB_IO_KICAD_SEXPR pcb_io( CTL_FOR_LIBRARY );
+
+    FP_CACHE cache( &pcb_io, libPath );
+    cache.Enumerate();
+
+    std::vector<wxString> names;
+
+    for( const auto& footprint : cache.GetFootprints() )
+        names.push_back( footprint.first );
+
+    BOOST_REQUIRE_GT( names.size(), 4 );
+
+    // Visiting every footprint, as the footprint list does, keeps the cache size limit
+    for( const wxString& name : names )
+    {
+        bool visited = cache.VisitFootprint( name,
+                [&]( const FOOTPRINT& aFootprint )
+                {
+                    BOOST_CHECK( aFootprint.GetFPID().GetLibItemName().wx_str() == name );
+                } );
+
+        BOOST_CHECK( visited );
+    }
+
+    size_t parsed = 0;
+
+    for( const auto& footprint : cache.GetFootprints() )
+    {
+        if( footprint.second->GetFootprint() )
+            parsed++;
+    }
+
+    BOOST_CHECK_EQUAL( parsed, 2 );
+
+    BOOST_CHECK( !cache.VisitFootprint( wxT( "no_such_footprint" ),
+                                        []( const FOOTPRINT& ) {} ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( FootprintCacheParseErrors )
+{
+    wxFileName libDir;
+    libDir.AssignDir( wxFileName::GetTempDir() );
+    libDir.AppendDir( wxString::Format( wxT( "qa_fp_cache_%lu.pretty" ), wxGetProcessId() ) );
+    libDir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+    wxString libPath = libDir.GetPath();
+    wxString sourcePath = KI_TEST::GetPcbnewTestDataDir()
+                          + "plugins/eagle/lbr/SparkFun-GPS.pretty/COPERNICUS.kicad_mod";
+
+    BOOST_REQUIRE( wxCopyFile( sourcePath,
+                               wxFileName( libPath, wxT( "COPERNICUS.kicad_mod" ) ).GetFullPath() ) );
+
+    wxFFile broken( wxFileName( libPath, wxT( "broken.kicad_mod" ) ).GetFullPath(), wxT( "w" ) );
+    BOOST_REQUIRE( broken.IsOpened() );
+    broken.Write( wxT( "(footprint \"broken\" (layer \"F.Cu\")" ) );
+    broken.Close();
+
+    PCB_IO_KICAD_SEXPR pcb_io( CTL_FOR_LIBRARY );
+    wxArrayString      names;
+
+    // Files are only parsed on demand, so the broken one is listed at first...
+    BOOST_CHECK_NO_THROW( pcb_io.FootprintEnumerate( names, libPath, false ) );
+    BOOST_CHECK_EQUAL( names.size(), 2 );
+
+    BOOST_CHECK_THROW( pcb_io.VisitEnumeratedFootprint( libPath, wxT( "broken" ),
+                                                        []( const FOOTPRINT& ) {} ),
+                       IO_ERROR );
+
+    // ...then it is reported by the next enumerations, and left out of the library
+    names.clear();
+    BOOST_CHECK_THROW( pcb_io.FootprintEnumerate( names, libPath, false ), IO_ERROR );
+
+    names.clear();
+    BOOST_CHECK_NO_THROW( pcb_io.FootprintEnumerate( names, libPath, true ) );
+    BOOST_REQUIRE_EQUAL( names.size(), 1 );
+    BOOST_CHECK( names[0] == wxT( "COPERNICUS" ) );
+
+    BOOST_CHECK( pcb_io.VisitEnumeratedFootprint( libPath, wxT( "COPERNICUS" ),
+                                                  []( const FOOTPRINT& ) {} ) );
+
+    wxFileName::Rmdir( libPath, wxPATH_RMDIR_RECURSIVE );
+}
@@ -0,0 +1,194 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pcb_track.h>
+#include <settings/settings_manager.h>
+#include <gendrill_Excellon_writer.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+
+struct GENDRILL_TEST_FIXTURE
+{
+    GENDRILL_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    /// Write the Excellon files of the board and return their contents, by file name
+    std::map<wxString, std::string> writeExcellonFiles( const wxString& aSubDir )
+    {
+        wxFileName dir;
+        dir.AssignDir( wxFileName::GetTempDir() );
+        dir.AppendDir( wxString::Format( wxT( "qa_gendrill_%lu" ), wxGetProcessId() ) );
+        dir.AppendDir( aSubDir );
+        dir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+        EXCELLON_WRITER writer( m_board.get() );
+
+        // The minimal header leaves out the creation date
+        writer.SetFormat( true );
+        writer.SetOptions( false, true, VECTOR2I( 0, 0 ), false );
+
+        BOOST_REQUIRE( writer.CreateDrillandMapFilesSet( dir.GetPath(), true, false ) );
+
+        std::map<wxString, std::string> files;
+        wxDir                           outDir( dir.GetPath() );
+        wxString                        name;
+
+        for( bool cont = outDir.GetFirst( &name ); cont; cont = outDir.GetNext( &name ) )
+        {
+            wxFFile  file( wxFileName( dir.GetPath(), name ).GetFullPath(), wxT( "rb" ) );
+            wxString content;
+
+            BOOST_REQUIRE( file.IsOpened() && file.ReadAll( &content, wxConvLatin1 ) );
+            files[name] = std::string( content.mb_str( wxConvLatin1 ) );
+        }
+
+        wxFileName::Rmdir( dir.GetPath(), wxPATH_RMDIR_RECURSIVE );
+
+        return files;
+    }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( GenDrill, GENDRILL_TEST_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( HilbertIndex )
+{
+    // The cells of the 4 x 4 corner of the grid are visited as by a 4 x 4 Hilbert curve
+    // (rows listed from y = 3 down to y = 0)
+    const uint64_t expected[4][4] = { {  5,  6,  9, 10 },
+                                      {  4,  7,  8, 11 },
+                                      {  3,  2, 13, 12 },
+                                      {  0,  1, 14, 15 } };
+
+    for( uint32_t y = 0; y < 4; y++ )
+    {
+        for( uint32_t x = 0; x < 4; x++ )
+        {
+            BOOST_TEST_CONTEXT( "Cell " << x << ", " << y )
+            {
+                BOOST_CHECK_EQUAL( GENDRILL_WRITER_BASE::HilbertIndex( x, y ),
+                                   expected[3 - y][x] );
+            }
+        }
+    }
+
+    // The curve starts and ends at the bottom corners of the full grid
+    BOOST_CHECK_EQUAL( GENDRILL_WRITER_BASE::HilbertIndex( 0, 0 ), 0ULL );
+    BOOST_CHECK_EQUAL( GENDRILL_WRITER_BASE::HilbertIndex( 65535, 0 ), 65536ULL * 65536 - 1 );
+
+    // Consecutive cells of the curve are neighbours on the grid
+    const uint32_t        size = 16;
+    std::vector<VECTOR2I> cells( size * size );
+
+    for( uint32_t y = 0; y < size; y++ )
+    {
+        for( uint32_t x = 0; x < size; x++ )
+        {
+            uint64_t index = GENDRILL_WRITER_BASE::HilbertIndex( x, y );
+
+            BOOST_REQUIRE_LT( index, cells.size() );
+            cells[index] = VECTOR2I( x, y );
+        }
+    }
+
+    for( size_t ii = 1; ii < cells.size(); ii++ )
+    {
+        VECTOR2I step = cells[ii] - cells[ii - 1];
+        BOOST_CHECK_EQUAL( std::abs( step.x ) + std::abs( step.y ), 1 );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( ExcellonOutputIgnoresItemOrder )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    std::map<wxString, std::string> reference = writeExcellonFiles( wxT( "reference" ) );
+
+    BOOST_REQUIRE( !reference.empty() );
+
+    // Holes are collected from the footprints, pads and tracks in the board's storage order
+    std::mt19937 rng( 42 );
+
+    for( int pass = 0; pass < 3; pass++ )
+    {
+        std::vector<BOARD_ITEM*> items;
+
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            std::shuffle( footprint->Pads().begin(), footprint->Pads().end(), rng );
+            items.push_back( footprint );
+        }
+
+        for( PCB_TRACK* track : m_board->Tracks() )
+            items.push_back( track );
+
+        std::shuffle( items.begin(), items.end(), rng );
+
+        for( BOARD_ITEM* item : items )
+            m_board->Remove( item, REMOVE_MODE::BULK );
+
+        m_board->FinalizeBulkRemove( items );
+
+        for( BOARD_ITEM* item : items )
+            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
+
+        m_board->FinalizeBulkAdd( items );
+
+        BOOST_TEST_CONTEXT( "Shuffle " << pass )
+        {
+            std::map<wxString, std::string> shuffled = writeExcellonFiles( wxT( "shuffled" ) );
+
+            BOOST_REQUIRE_EQUAL( shuffled.size(), reference.size() );
+
+            for( const auto& [name, content] : reference )
+            {
+                BOOST_TEST_CONTEXT( name )
+                {
+                    BOOST_REQUIRE( shuffled.count( name ) );
+                    BOOST_CHECK( shuffled[name] == content );
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
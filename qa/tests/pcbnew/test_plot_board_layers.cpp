@@ -0,0 +1,180 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <core/thread_pool.h>
+#include <locale_io.h>
+#include <pcb_plot_params.h>
+#include <pcbplot.h>
+#include <plotters/plotter.h>
+#include <settings/settings_manager.h>
+
+#include <map>
+
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+#include <wx/utils.h>
+
+
+struct PLOT_BOARD_LAYERS_FIXTURE
+{
+    PLOT_BOARD_LAYERS_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    /**
+     * Plot each layer of the board to its own Gerber file, along with the board edges, and
+     * return the files contents by file name.
+     */
+    std::map<wxString, std::string> plotLayers( const wxString& aSubDir, bool aConcurrent )
+    {
+        wxFileName dir;
+        dir.AssignDir( wxFileName::GetTempDir() );
+        dir.AppendDir( wxString::Format( wxT( "qa_plot_board_layers_%lu" ), wxGetProcessId() ) );
+        dir.AppendDir( aSubDir );
+        dir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+        PCB_PLOT_PARAMS plotOpts;
+        plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+
+        BOARD* board = m_board.get();
+
+        auto plotLayer =
+                [&]( PCB_LAYER_ID aLayer ) -> bool
+                {
+                    wxString fullPath = wxFileName( dir.GetPath(),
+                                                    board->GetLayerName( aLayer ) + wxT( ".gbr" ) )
+                                                .GetFullPath();
+
+                    PLOTTER* plotter = StartPlotBoard( board, &plotOpts, aLayer,
+                                                       board->GetLayerName( aLayer ), fullPath,
+                                                       wxEmptyString, wxEmptyString );
+
+                    if( !plotter )
+                        return false;
+
+                    PlotBoardLayers( board, plotter, { aLayer, Edge_Cuts }, plotOpts );
+                    plotter->EndPlot();
+
+                    delete plotter->RenderSettings();
+                    delete plotter;
+                    return true;
+                };
+
+        LOCALE_IO toggle;
+        LSEQ      layers = ( LSET::AllCuMask( board->GetCopperLayerCount() )
+                             | LSET::AllTechMask() ).UIOrder();
+
+        if( aConcurrent )
+        {
+            PrepareBoardForConcurrentPlot( board );
+
+            thread_pool&                   tp = GetKiCadThreadPool();
+            std::vector<std::future<bool>> returns;
+
+            for( PCB_LAYER_ID layer : layers )
+                returns.emplace_back( tp.submit( plotLayer, layer ) );
+
+            for( std::future<bool>& ret : returns )
+                BOOST_CHECK( ret.get() );
+        }
+        else
+        {
+            for( PCB_LAYER_ID layer : layers )
+                BOOST_CHECK( plotLayer( layer ) );
+        }
+
+        std::map<wxString, std::string> files;
+        wxDir                           outDir( dir.GetPath() );
+        wxString                        name;
+
+        for( bool cont = outDir.GetFirst( &name ); cont; cont = outDir.GetNext( &name ) )
+        {
+            wxFFile  file( wxFileName( dir.GetPath(), name ).GetFullPath(), wxT( "rb" ) );
+            wxString content;
+
+            BOOST_REQUIRE( file.IsOpened() && file.ReadAll( &content, wxConvLatin1 ) );
+
+            // The plot date is the only thing expected to change between two plots
+            wxString          stripped;
+            wxStringTokenizer lines( content, wxT( "\n" ) );
+
+            while( lines.HasMoreTokens() )
+            {
+                wxString line = lines.GetNextToken();
+
+                if( !line.StartsWith( wxT( "G04 Created by KiCad" ) )
+                        && !line.Contains( wxT( "CreationDate" ) ) )
+                {
+                    stripped << line << wxT( "\n" );
+                }
+            }
+
+            files[name] = std::string( stripped.mb_str( wxConvLatin1 ) );
+        }
+
+        wxFileName::Rmdir( dir.GetPath(), wxPATH_RMDIR_RECURSIVE );
+
+        return files;
+    }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PlotBoardLayers, PLOT_BOARD_LAYERS_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( ConcurrentPlotMatchesSerialPlot )
+{
+    for( const wxString& boardName : { wxT( "complex_hierarchy" ), wxT( "api_kitchen_sink" ) } )
+    {
+        BOOST_TEST_CONTEXT( boardName )
+        {
+            KI_TEST::LoadBoard( m_settingsManager, boardName, m_board );
+
+            std::map<wxString, std::string> serial = plotLayers( wxT( "serial" ), false );
+            std::map<wxString, std::string> concurrent = plotLayers( wxT( "concurrent" ), true );
+
+            BOOST_REQUIRE( !serial.empty() );
+            BOOST_REQUIRE_EQUAL( concurrent.size(), serial.size() );
+
+            for( const auto& [name, content] : serial )
+            {
+                BOOST_TEST_CONTEXT( name )
+                {
+                    BOOST_REQUIRE( concurrent.count( name ) );
+                    BOOST_CHECK( concurrent[name] == content );
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,9 @@
 #include <router/pns_router.h>
 #include <router/pns_item.h>
 #include <router/pns_via.h>
+#include <router/pns_line.h>
+#include <router/pns_optimizer.h>
+#include <router/pns_routing_settings.h>
 #include <router/pns_kicad_iface.h>
 
 static bool isCopper( const PNS::ITEM* aItem )
@@ -303,14 +306,17 @@ private:
 struct PNS_TEST_FIXTURE
 {
     PNS_TEST_FIXTURE() :
-        m_settingsManager( true /* headless */ )
+        m_settingsManager( true /* headless */ ),
+        m_routingSettings( nullptr, "" )
     {
         m_router = new PNS::ROUTER;
         m_iface = new MOCK_PNS_KICAD_IFACE( this );
         m_router->SetInterface( m_iface );
+        m_router->LoadSettings( &m_routingSettings );
     }
 
     SETTINGS_MANAGER      m_settingsManager;
+    PNS::ROUTING_SETTINGS m_routingSettings;
     PNS::ROUTER*          m_router;
     MOCK_RULE_RESOLVER    m_ruleResolver;
     MOCK_PNS_KICAD_IFACE* m_iface;
@@ -408,5 +414,156 @@ BOOST_FIXTURE_TEST_CASE( PNSHoleCollisions, PNS_TEST_FIXTURE )
 
         BOOST_CHECK_EQUAL( first.m_clearance, m_ruleResolver.m_defaultHole2Copper );
     }
+
+    BOOST_TEST_MESSAGE( "via to via, flat obstacle buffer" );
+    {
+        PNS::OBSTACLE_LIST obstacles;
+
+        int count = world->QueryColliding( v1, obstacles );
+        BOOST_CHECK_EQUAL( count, 2 );
+
+        // Querying the same item again must not add duplicate obstacles
+        count = world->QueryColliding( v1, obstacles );
+        BOOST_CHECK_EQUAL( count, 2 );
+        BOOST_CHECK_EQUAL( obstacles.Size(), 2 );
+    }
+
+    BOOST_TEST_MESSAGE( "via to via, results added to the caller's set" );
+    {
+        PNS::NODE::OBSTACLES obstacles;
+
+        BOOST_CHECK_EQUAL( world->QueryColliding( v1, obstacles ), 2 );
+        BOOST_CHECK_EQUAL( world->QueryColliding( v1, obstacles ), 2 );
+        BOOST_CHECK_EQUAL( obstacles.size(), 2 );
+    }
 }
 
+
+
+BOOST_FIXTURE_TEST_CASE( PNSBranchRecycling, PNS_TEST_FIXTURE )
+{
+    PNS::VIA* v1 = new PNS::VIA( VECTOR2I( 0, 1000000 ), PNS_LAYER_RANGE( F_Cu, B_Cu ), 50000, 10000 );
+
+    std::unique_ptr<PNS::NODE> world ( new PNS::NODE );
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+    m_ruleResolver.m_defaultClearance = 1000000;
+
+    world->AddRaw( v1 );
+
+    PNS::NODE* branch = world->Branch();
+    branch->Add( std::make_unique<PNS::VIA>( VECTOR2I( 0, 2000000 ), PNS_LAYER_RANGE( F_Cu, B_Cu ),
+                                             50000, 10000 ) );
+
+    {
+        PNS::NODE::OBSTACLES obstacles;
+        BOOST_CHECK_GT( branch->QueryColliding( v1, obstacles ), 0 );
+    }
+
+    world->KillChildren();
+    BOOST_CHECK( !world->HasChildren() );
+
+    BOOST_TEST_MESSAGE( "killed branch is reused and comes back empty" );
+    {
+        PNS::NODE* recycled = world->Branch();
+
+        BOOST_CHECK_EQUAL( recycled, branch );
+        BOOST_CHECK_EQUAL( recycled->Depth(), 1 );
+        BOOST_CHECK_EQUAL( recycled->GetParent(), world.get() );
+
+        PNS::NODE::OBSTACLES obstacles;
+        BOOST_CHECK_EQUAL( recycled->QueryColliding( v1, obstacles ), 0 );
+    }
+
+    world->KillChildren();
+}
+
+
+BOOST_FIXTURE_TEST_CASE( PNSNodeRevision, PNS_TEST_FIXTURE )
+{
+    std::unique_ptr<PNS::NODE> world ( new PNS::NODE );
+
+    world->SetRuleResolver( &m_ruleResolver );
+
+    uint64_t emptyRev = world->Revision();
+
+    world->Add( std::make_unique<PNS::VIA>( VECTOR2I( 0, 1000000 ), PNS_LAYER_RANGE( F_Cu, B_Cu ),
+                                            50000, 10000 ) );
+
+    uint64_t rootRev = world->Revision();
+    BOOST_CHECK_NE( rootRev, emptyRev );
+
+    BOOST_TEST_MESSAGE( "an unmodified branch has the contents, and so the revision, of its parent" );
+    PNS::NODE* branch = world->Branch();
+    BOOST_CHECK_EQUAL( branch->Revision(), rootRev );
+
+    BOOST_TEST_MESSAGE( "modifying a branch gives it a new revision and leaves the parent alone" );
+    branch->Add( std::make_unique<PNS::VIA>( VECTOR2I( 0, 2000000 ), PNS_LAYER_RANGE( F_Cu, B_Cu ),
+                                             50000, 10000 ) );
+    BOOST_CHECK_NE( branch->Revision(), rootRev );
+    BOOST_CHECK_EQUAL( world->Revision(), rootRev );
+
+    BOOST_TEST_MESSAGE( "modifying a node gives new revisions to all the branches below it" );
+    PNS::NODE* subBranch = branch->Branch();
+    uint64_t   branchRev = branch->Revision();
+
+    BOOST_CHECK_EQUAL( subBranch->Revision(), branchRev );
+
+    world->Add( std::make_unique<PNS::VIA>( VECTOR2I( 0, 3000000 ), PNS_LAYER_RANGE( F_Cu, B_Cu ),
+                                            50000, 10000 ) );
+    BOOST_CHECK_NE( world->Revision(), rootRev );
+    BOOST_CHECK_NE( branch->Revision(), branchRev );
+    BOOST_CHECK_NE( subBranch->Revision(), branchRev );
+    BOOST_CHECK_NE( subBranch->Revision(), world->Revision() );
+
+    world->KillChildren();
+}
+
+
+BOOST_FIXTURE_TEST_CASE( PNSOptimizerCacheParentChange, PNS_TEST_FIXTURE )
+{
+    std::unique_ptr<PNS::NODE> world ( new PNS::NODE );
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    PNS::NODE* branch = world->Branch();
+
+    // An L-shaped line, which the optimizer turns into a single diagonal when nothing is in
+    // the way
+    PNS::LINE line;
+    line.SetShape( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( 10000000, 0 ),
+                                       VECTOR2I( 10000000, 10000000 ) } ) );
+    line.SetWidth( 250000 );
+    line.SetLayer( F_Cu );
+
+    PNS::LINE first( line );
+    BOOST_REQUIRE( PNS::OPTIMIZER::Optimize( &first, PNS::OPTIMIZER::MERGE_SEGMENTS, branch ) );
+    BOOST_CHECK( !branch->CheckColliding( &first ).has_value() );
+
+    // Put a via on the optimized path, away from the original line, in the parent node
+    VECTOR2I blocker;
+    bool     found = false;
+
+    for( int i = 0; i < first.CLine().SegmentCount() && !found; i++ )
+    {
+        blocker = first.CLine().CSegment( i ).Center();
+        found = line.CLine().SquaredDistance( blocker, true ) > SEG::Square( 2000000 );
+    }
+
+    BOOST_REQUIRE( found );
+
+    world->Add( std::make_unique<PNS::VIA>( blocker, PNS_LAYER_RANGE( F_Cu, B_Cu ), 500000,
+                                            250000 ) );
+    BOOST_CHECK( branch->CheckColliding( &first ).has_value() );
+
+    BOOST_TEST_MESSAGE( "the branch doesn't get the result computed before its parent changed" );
+    PNS::LINE second( line );
+    PNS::OPTIMIZER::Optimize( &second, PNS::OPTIMIZER::MERGE_SEGMENTS, branch );
+
+    BOOST_CHECK( !branch->CheckColliding( &second ).has_value() );
+    BOOST_CHECK( second.CLine().CPoints() != first.CLine().CPoints() );
+
+    world->KillChildren();
+}
@@ -0,0 +1,174 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <connectivity/connectivity_data.h>
+#include <ratsnest/ratsnest_data.h>
+#include <settings/settings_manager.h>
+
+
+struct RATSNEST_TEST_FIXTURE
+{
+    RATSNEST_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+static double totalLength( RN_NET* aNet )
+{
+    double length = 0.0;
+
+    for( const CN_EDGE& edge : aNet->GetEdges() )
+        length += edge.GetLength();
+
+    return length;
+}
+
+
+/**
+ * Check the ratsnest of \a aConnectivity against a ratsnest computed from scratch.
+ */
+static void checkAgainstFreshBuild( BOARD* aBoard,
+                                    const std::shared_ptr<CONNECTIVITY_DATA>& aConnectivity,
+                                    int aStep )
+{
+    std::shared_ptr<CONNECTIVITY_DATA> reference = std::make_shared<CONNECTIVITY_DATA>();
+    reference->Build( aBoard );
+    reference->RecalculateRatsnest();
+
+    BOOST_REQUIRE_EQUAL( aConnectivity->GetNetCount(), reference->GetNetCount() );
+
+    for( int net = 1; net < reference->GetNetCount(); net++ )
+    {
+        RN_NET* incremental = aConnectivity->GetRatsnestForNet( net );
+        RN_NET* expected = reference->GetRatsnestForNet( net );
+
+        if( !incremental || !expected )
+        {
+            BOOST_CHECK( !incremental && !expected );
+            continue;
+        }
+
+        BOOST_TEST_CONTEXT( "Step " << aStep << ", net " << net )
+        {
+            BOOST_CHECK_EQUAL( incremental->GetEdges().size(), expected->GetEdges().size() );
+            BOOST_CHECK_CLOSE( totalLength( incremental ), totalLength( expected ), 0.01 );
+        }
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( RatsnestIncrementalUpdate, RATSNEST_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    connectivity->RecalculateRatsnest();
+
+    std::vector<FOOTPRINT*> footprints( m_board->Footprints().begin(),
+                                        m_board->Footprints().end() );
+
+    BOOST_REQUIRE( footprints.size() > 10 );
+
+    // Move a few footprints at a time, so that the ratsnest gets updated incrementally, and
+    // check the result against a ratsnest computed from scratch after every step
+    for( int step = 0; step < 5; step++ )
+    {
+        for( size_t i = step; i < footprints.size(); i += 17 )
+        {
+            footprints[i]->Move( VECTOR2I( pcbIUScale.mmToIU( 1.5 * ( step + 1 ) ),
+                                           pcbIUScale.mmToIU( -2.0 * step ) ) );
+            connectivity->Update( footprints[i] );
+        }
+
+        connectivity->RecalculateRatsnest();
+
+        checkAgainstFreshBuild( m_board.get(), connectivity, step );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( RatsnestIncrementalUpdateOutsideHull, RATSNEST_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    connectivity->RecalculateRatsnest();
+
+    // Use the net with the most pads, so that moving a single pad is a small enough change
+    // for the triangulation to be updated locally
+    std::vector<BOARD_CONNECTED_ITEM*> pads;
+
+    for( int net = 1; net < connectivity->GetNetCount(); net++ )
+    {
+        std::vector<BOARD_CONNECTED_ITEM*> netPads = connectivity->GetNetItems( net,
+                                                                                { PCB_PAD_T } );
+
+        if( netPads.size() > pads.size() )
+            pads = std::move( netPads );
+    }
+
+    BOOST_REQUIRE( pads.size() >= 16 );
+
+    BOX2I netBBox;
+
+    for( BOARD_CONNECTED_ITEM* pad : pads )
+        netBBox.Merge( pad->GetPosition() );
+
+    // Move a pad of the hull further outside the hull, then another one around the net, and
+    // finally back inside
+    auto rightmost = std::max_element( pads.begin(), pads.end(),
+            []( BOARD_CONNECTED_ITEM* a, BOARD_CONNECTED_ITEM* b )
+            {
+                return a->GetPosition().x < b->GetPosition().x;
+            } );
+
+    PAD* pad = static_cast<PAD*>( *rightmost );
+    PAD* other = static_cast<PAD*>( pads.front() == pad ? pads.back() : pads.front() );
+
+    std::vector<std::pair<PAD*, VECTOR2I>> moves = {
+        { pad,   pad->GetPosition() + VECTOR2I( netBBox.GetWidth() / 2, 0 ) },
+        { other, netBBox.GetOrigin() - VECTOR2I( 0, netBBox.GetHeight() ) },
+        { pad,   netBBox.Centre() },
+        { other, netBBox.Centre() + VECTOR2I( pcbIUScale.mmToIU( 1 ), 0 ) }
+    };
+
+    for( size_t step = 0; step < moves.size(); step++ )
+    {
+        auto& [movedPad, target] = moves[step];
+
+        movedPad->Move( target - movedPad->GetPosition() );
+        connectivity->Update( movedPad );
+        connectivity->RecalculateRatsnest();
+
+        checkAgainstFreshBuild( m_board.get(), connectivity, step );
+    }
+}
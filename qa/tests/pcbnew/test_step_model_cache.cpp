@@ -0,0 +1,232 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <qa_utils/advanced_cfg_override.h>
+#include <base_units.h>
+#include <exporters/step/step_pcb_model.h>
+
+#include <Standard_Version.hxx>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+
+struct STEP_MODEL_CACHE_FIXTURE
+{
+    STEP_MODEL_CACHE_FIXTURE()
+    {
+        m_stackup.BuildDefaultStackupList( nullptr, 2 );
+
+        wxFileName dir;
+        dir.AssignDir( wxFileName::GetTempDir() );
+        dir.AppendDir( wxString::Format( wxT( "qa_step_model_cache_%lu" ), wxGetProcessId() ) );
+        dir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+        m_modelA = wxFileName( dir.GetPath(), wxT( "model_a.step" ) ).GetFullPath();
+        m_modelB = wxFileName( dir.GetPath(), wxT( "model_b.step" ) ).GetFullPath();
+        m_dir = dir.GetPath();
+    }
+
+    ~STEP_MODEL_CACHE_FIXTURE()
+    {
+        for( const wxString& model : { m_modelA, m_modelB } )
+        {
+            if( wxFileName::FileExists( model ) )
+                wxRemoveFile( STEP_PCB_MODEL::GetModelCacheFile( model ) );
+        }
+
+        wxFileName::Rmdir( m_dir, wxPATH_RMDIR_RECURSIVE );
+    }
+
+    void addOutline( STEP_PCB_MODEL& aModel, double aWidth, double aHeight )
+    {
+        SHAPE_POLY_SET outline;
+
+        outline.NewOutline();
+        outline.Append( 0, 0 );
+        outline.Append( pcbIUScale.mmToIU( aWidth ), 0 );
+        outline.Append( pcbIUScale.mmToIU( aWidth ), pcbIUScale.mmToIU( aHeight ) );
+        outline.Append( 0, pcbIUScale.mmToIU( aHeight ) );
+
+        aModel.SetStackup( m_stackup );
+        BOOST_REQUIRE( aModel.CreatePCB( outline, VECTOR2D( 0, 0 ), true ) );
+    }
+
+    /// Write a small board as a STEP file, to be used as a 3D model
+    void writeModel( const wxString& aFileName, double aWidth, double aHeight )
+    {
+        STEP_PCB_MODEL model( wxT( "model" ) );
+
+        addOutline( model, aWidth, aHeight );
+        BOOST_REQUIRE( model.WriteSTEP( aFileName, false ) );
+    }
+
+    /// Place a model twice on a board and return the resulting assembly in BREP format
+    std::string exportAssembly( const wxString& aModelFile, bool aPreload )
+    {
+        STEP_PCB_MODEL model( wxT( "assembly" ) );
+        std::string    modelFile( aModelFile.ToUTF8() );
+
+        addOutline( model, 40.0, 30.0 );
+
+        if( aPreload )
+            model.PreloadModels( { modelFile, modelFile }, false );
+
+        BOOST_CHECK( model.AddComponent( modelFile, "U1", false, VECTOR2D( 10.0, 10.0 ), 0.0,
+                                         VECTOR3D( 0, 0, 0 ), VECTOR3D( 0, 0, 0 ),
+                                         VECTOR3D( 1, 1, 1 ), false ) );
+        BOOST_CHECK( model.AddComponent( modelFile, "U2", true, VECTOR2D( 25.0, 15.0 ), 90.0,
+                                         VECTOR3D( 0, 0, 0 ), VECTOR3D( 0, 0, 0 ),
+                                         VECTOR3D( 1, 1, 1 ), false ) );
+
+        wxString brepFile = wxFileName( m_dir, wxT( "assembly.brep" ) ).GetFullPath();
+        BOOST_REQUIRE( model.WriteBREP( brepFile ) );
+
+        wxFFile  file( brepFile, wxT( "rb" ) );
+        wxString content;
+
+        BOOST_REQUIRE( file.IsOpened() && file.ReadAll( &content, wxConvLatin1 ) );
+
+        return std::string( content.mb_str( wxConvLatin1 ) );
+    }
+
+    BOARD_STACKUP  m_stackup;
+    wxString       m_dir;
+    wxString       m_modelA;
+    wxString       m_modelB;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( StepModelCache, STEP_MODEL_CACHE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( PreloadMatchesSerialRead )
+{
+    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> skipCache( &ADVANCED_CFG::m_Skip3DModelFileCache, true );
+
+    writeModel( m_modelA, 8.0, 5.0 );
+    wxRemoveFile( STEP_PCB_MODEL::GetModelCacheFile( m_modelA ) );
+
+    std::string serial = exportAssembly( m_modelA, false );
+
+    BOOST_CHECK( !serial.empty() );
+    BOOST_CHECK( serial == exportAssembly( m_modelA, true ) );
+
+    // Skip3DModelFileCache leaves the cache untouched
+    BOOST_CHECK( !wxFileName::FileExists( STEP_PCB_MODEL::GetModelCacheFile( m_modelA ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( CacheKey )
+{
+    writeModel( m_modelA, 8.0, 5.0 );
+    writeModel( m_modelB, 4.0, 4.0 );
+
+    wxString keyA = STEP_PCB_MODEL::GetModelCacheFile( m_modelA );
+
+    BOOST_REQUIRE( !keyA.IsEmpty() );
+    BOOST_CHECK( keyA.EndsWith( wxT( ".xbf" ) ) );
+    BOOST_CHECK( keyA == STEP_PCB_MODEL::GetModelCacheFile( m_modelA ) );
+    BOOST_CHECK( keyA != STEP_PCB_MODEL::GetModelCacheFile( m_modelB ) );
+
+    // A changed model file gets a new cache entry
+    writeModel( m_modelA, 12.0, 5.0 );
+    BOOST_CHECK( keyA != STEP_PCB_MODEL::GetModelCacheFile( m_modelA ) );
+
+    // No cache entry for a missing file
+    BOOST_CHECK( STEP_PCB_MODEL::GetModelCacheFile( m_dir + wxT( "/missing.step" ) ).IsEmpty() );
+}
+
+
+#if OCC_VERSION_HEX >= 0x070500
+BOOST_AUTO_TEST_CASE( CacheRoundTrip )
+{
+    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> skipCache( &ADVANCED_CFG::m_Skip3DModelFileCache, false );
+
+    writeModel( m_modelA, 8.0, 5.0 );
+    writeModel( m_modelB, 4.0, 4.0 );
+
+    wxString cacheA = STEP_PCB_MODEL::GetModelCacheFile( m_modelA );
+    wxString cacheB = STEP_PCB_MODEL::GetModelCacheFile( m_modelB );
+
+    wxRemoveFile( cacheA );
+    wxRemoveFile( cacheB );
+
+    std::string serialA = exportAssembly( m_modelA, false );
+    std::string serialB = exportAssembly( m_modelB, false );
+
+    BOOST_CHECK( serialA != serialB );
+
+    // The first preload reads the model file and writes the cache entry
+    BOOST_CHECK( serialA == exportAssembly( m_modelA, true ) );
+    BOOST_REQUIRE( wxFileName::FileExists( cacheA ) );
+
+    // The next one reads the cache entry
+    BOOST_CHECK( serialA == exportAssembly( m_modelA, true ) );
+
+    // Check the cache entry is really used in place of the model file: give model A the
+    // cached data of model B
+    BOOST_CHECK( serialB == exportAssembly( m_modelB, true ) );
+    BOOST_REQUIRE( wxFileName::FileExists( cacheB ) );
+    BOOST_REQUIRE( wxCopyFile( cacheB, cacheA, true ) );
+
+    BOOST_CHECK( serialB == exportAssembly( m_modelA, true ) );
+    BOOST_CHECK( serialA == exportAssembly( m_modelA, false ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( CacheCleanedWhenAllModelsCached )
+{
+    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> skipCache( &ADVANCED_CFG::m_Skip3DModelFileCache, false );
+
+    writeModel( m_modelA, 8.0, 5.0 );
+
+    wxString cacheA = STEP_PCB_MODEL::GetModelCacheFile( m_modelA );
+
+    wxRemoveFile( cacheA );
+    exportAssembly( m_modelA, true );
+    BOOST_REQUIRE( wxFileName::FileExists( cacheA ) );
+
+    // An entry that hasn't been used for long is removed even when no model is read
+    wxFileName stale( wxFileName( cacheA ).GetPath(),
+                      wxString::Format( wxT( "qa_stale_%lu" ), wxGetProcessId() ), wxT( "xbf" ) );
+    wxDateTime staleTime = wxDateTime::Now() - wxDateSpan::Days( 60 );
+    wxFFile    staleFile( stale.GetFullPath(), wxT( "wb" ) );
+
+    BOOST_REQUIRE( staleFile.IsOpened() );
+    staleFile.Close();
+    BOOST_REQUIRE( stale.SetTimes( &staleTime, &staleTime, nullptr ) );
+
+    exportAssembly( m_modelA, true );
+
+    BOOST_CHECK( !stale.FileExists() );
+    BOOST_CHECK( wxFileName::FileExists( cacheA ) );
+
+    wxRemoveFile( stale.GetFullPath() );
+}
+#endif
+
+
+BOOST_AUTO_TEST_SUITE_END()
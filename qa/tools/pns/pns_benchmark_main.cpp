@@ -0,0 +1,359 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Headless router benchmark.  Replays a corpus of recorded router sessions (the same logs as
+ * used by qa_pns_regressions) and writes a JSON summary of the per-event latency, collision
+ * query and heap allocation counts, grouped by the routing mode that was active.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <new>
+
+#include <wx/cmdline.h>
+#include <wx/ffile.h>
+#include <wx/init.h>
+#include <wx/textfile.h>
+
+#include <nlohmann/json.hpp>
+
+#include <pgm_base.h>
+#include <reporter.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+
+static std::atomic<uint64_t> s_allocationCount( 0 );
+
+// Count every allocation of the process.  The array forms forward to these.
+void* operator new( std::size_t aSize )
+{
+    s_allocationCount.fetch_add( 1, std::memory_order_relaxed );
+
+    if( void* ptr = std::malloc( aSize ? aSize : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete( void* aPtr ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete( void* aPtr, std::size_t ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            "displays help on the command line parameters",
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "o",
+            "output",
+            "JSON summary file (default: standard output)",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "n",
+            "iterations",
+            "number of times each log is replayed (default: 1)",
+            wxCMD_LINE_VAL_NUMBER,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            "logs",
+            "logs",
+            "log file names (no extensions), default: the pns_regressions corpus",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+struct STEP_SAMPLES
+{
+    std::vector<double> m_timesMs;
+    uint64_t            m_collisionQueries = 0;
+    uint64_t            m_allocations = 0;
+
+    void Add( const PNS_LOG_PLAYER::EVENT_STATS& aStats )
+    {
+        m_timesMs.push_back( aStats.m_timeMs );
+        m_collisionQueries += aStats.m_collisionQueries;
+        m_allocations += aStats.m_allocations;
+    }
+
+    nlohmann::json ToJson()
+    {
+        nlohmann::json j;
+
+        std::sort( m_timesMs.begin(), m_timesMs.end() );
+
+        // Nearest-rank percentile of the sorted samples
+        auto percentile =
+                [&]( double aPercent ) -> double
+                {
+                    if( m_timesMs.empty() )
+                        return 0.0;
+
+                    size_t rank = (size_t) std::ceil( aPercent / 100.0 * m_timesMs.size() );
+                    return m_timesMs[ std::clamp<size_t>( rank, 1, m_timesMs.size() ) - 1 ];
+                };
+
+        double total = 0.0;
+
+        for( double t : m_timesMs )
+            total += t;
+
+        size_t count = m_timesMs.size();
+
+        j["count"] = count;
+        j["total_ms"] = total;
+        j["mean_ms"] = count ? total / count : 0.0;
+        j["p50_ms"] = percentile( 50.0 );
+        j["p90_ms"] = percentile( 90.0 );
+        j["p99_ms"] = percentile( 99.0 );
+        j["max_ms"] = m_timesMs.empty() ? 0.0 : m_timesMs.back();
+        j["collision_queries"] = m_collisionQueries;
+        j["collision_queries_per_step"] = count ? (double) m_collisionQueries / count : 0.0;
+        j["allocations"] = m_allocations;
+        j["allocations_per_step"] = count ? (double) m_allocations / count : 0.0;
+
+        return j;
+    }
+};
+
+
+// category (shove, walkaround, ...) -> event name (move, fix, ...) -> samples
+typedef std::map<std::string, std::map<std::string, STEP_SAMPLES>> SAMPLE_MAP;
+
+
+static std::string eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE: return "route-start";
+    case PNS::LOGGER::EVT_START_DRAG:  return "drag-start";
+    case PNS::LOGGER::EVT_FIX:         return "fix";
+    case PNS::LOGGER::EVT_MOVE:        return "move";
+    case PNS::LOGGER::EVT_ABORT:       return "abort";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:  return "toggle-via";
+    case PNS::LOGGER::EVT_UNFIX:       return "unfix";
+    default:                           return "unknown";
+    }
+}
+
+
+static std::string routeCategory( const PNS_LOG_FILE& aLog )
+{
+    if( aLog.GetMode() == PNS::PNS_MODE_ROUTE_DIFF_PAIR )
+        return "diff_pair";
+
+    switch( aLog.GetRoutingSettings()->Mode() )
+    {
+    case PNS::RM_Shove:      return "shove";
+    case PNS::RM_Walkaround: return "walkaround";
+    default:                 return "mark_obstacles";
+    }
+}
+
+
+static std::vector<wxString> defaultCorpus()
+{
+    std::vector<wxString> logs;
+    wxString              absPath = KI_TEST::GetPcbnewTestDataDir() + "/pns_regressions/";
+    wxTextFile            fp( absPath + "tests.lst" );
+
+    if( !fp.Open() )
+        return logs;
+
+    for( size_t i = 0; i < fp.GetLineCount(); i++ )
+    {
+        if( !fp[i].IsEmpty() )
+            logs.push_back( absPath + fp[i] + wxT( "/pns" ) );
+    }
+
+    fp.Close();
+
+    return logs;
+}
+
+
+static bool benchmarkLog( const wxString& aLogName, long aIterations, SAMPLE_MAP& aTotals,
+                          nlohmann::json& aLogJson )
+{
+    PNS_LOG_FILE logFile;
+
+    if( !logFile.Load( wxFileName( aLogName ), &NULL_REPORTER::GetInstance() ) )
+        return false;
+
+    SAMPLE_MAP samples;
+
+    for( long iter = 0; iter < aIterations; iter++ )
+    {
+        PNS_LOG_PLAYER player;
+
+        player.SetDebugEnabled( false );
+        player.SetAllocationCounter(
+                []()
+                {
+                    return s_allocationCount.load( std::memory_order_relaxed );
+                } );
+
+        player.ReplayLog( &logFile, 0 );
+
+        // Events are attributed to the kind of session they belong to
+        std::string category = routeCategory( logFile );
+
+        for( const PNS_LOG_PLAYER::EVENT_STATS& stats : player.GetEventStats() )
+        {
+            if( stats.m_type == PNS::LOGGER::EVT_START_DRAG )
+                category = "drag";
+            else if( stats.m_type == PNS::LOGGER::EVT_START_ROUTE )
+                category = routeCategory( logFile );
+
+            samples[category][eventName( stats.m_type )].Add( stats );
+            aTotals[category][eventName( stats.m_type )].Add( stats );
+        }
+    }
+
+    aLogJson["log"] = aLogName.ToStdString();
+    aLogJson["events"] = logFile.Events().size();
+    aLogJson["iterations"] = aIterations;
+
+    for( auto& [category, events] : samples )
+    {
+        for( auto& [name, eventSamples] : events )
+            aLogJson["modes"][category][name] = eventSamples.ToJson();
+    }
+
+    return true;
+}
+
+
+int main( int argc, char** argv )
+{
+    wxInitialize( argc, argv );
+
+    Pgm().InitPgm( true );
+
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( wxT( "Replays P&S router logs headlessly and reports the router "
+                                 "performance as JSON." ) );
+
+    int  ret = cl_parser.Parse();
+    long iterations = 1;
+    int  failed = 0;
+
+    if( ret != 0 )
+    {
+        Pgm().Destroy();
+        wxUninitialize();
+        return ret == -1 ? 0 : 1;
+    }
+
+    cl_parser.Found( wxT( "iterations" ), &iterations );
+    iterations = std::max( iterations, 1L );
+
+    std::vector<wxString> logs;
+
+    for( size_t i = 0; i < cl_parser.GetParamCount(); i++ )
+        logs.push_back( cl_parser.GetParam( i ) );
+
+    if( logs.empty() )
+        logs = defaultCorpus();
+
+    SAMPLE_MAP     totals;
+    nlohmann::json summary;
+
+    summary["logs"] = nlohmann::json::array();
+
+    for( const wxString& logName : logs )
+    {
+        nlohmann::json logJson;
+
+        if( benchmarkLog( logName, iterations, totals, logJson ) )
+        {
+            summary["logs"].push_back( logJson );
+        }
+        else
+        {
+            fprintf( stderr, "Failed to load log '%s'\n", (const char*) logName.c_str() );
+            failed++;
+        }
+    }
+
+    for( auto& [category, events] : totals )
+    {
+        for( auto& [name, eventSamples] : events )
+            summary["modes"][category][name] = eventSamples.ToJson();
+    }
+
+    summary["failed_logs"] = failed;
+
+    std::string output = summary.dump( 2 ) + "\n";
+    wxString    outputFile;
+
+    if( cl_parser.Found( wxT( "output" ), &outputFile ) )
+    {
+        wxFFile file( outputFile, wxT( "wb" ) );
+
+        if( !file.IsOpened() || !file.Write( output.c_str(), output.size() ) )
+        {
+            fprintf( stderr, "Failed to write '%s'\n", (const char*) outputFile.c_str() );
+            failed++;
+        }
+    }
+    else
+    {
+        fputs( output.c_str(), stdout );
+    }
+
+    Pgm().Destroy();
+    wxUninitialize();
+
+    return failed ? 1 : 0;
+}
@@ -26,12 +26,14 @@
 #include "pns_log_player.h"
 
 #include <pcbnew_utils/board_test_utils.h>
+#include <core/profile.h>
 
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
 
-PNS_LOG_PLAYER::PNS_LOG_PLAYER()
+PNS_LOG_PLAYER::PNS_LOG_PLAYER() :
+        m_debugEnabled( true )
 {
     SetReporter( &NULL_REPORTER::GetInstance() );
 }
@@ -58,6 +60,7 @@ void PNS_LOG_PLAYER::createRouter()
 
     m_debugDecorator = new PNS_TEST_DEBUG_DECORATOR( m_reporter );
     m_debugDecorator->Clear();
+    m_debugDecorator->SetDebugEnabled( m_debugEnabled );
     m_iface->SetDebugDecorator( m_debugDecorator );
 }
 
@@ -102,6 +105,9 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
 
+    m_eventStats.clear();
+    m_eventStats.reserve( totalEvents );
+
     for( auto evt : aLog->Events() )
     {
         if( eventIdx < aFrom || ( aTo >= 0 && eventIdx > aTo ) )
@@ -113,6 +119,21 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        // Only the router calls are timed.  Note that they include the cost of the debug
+        // decorator output unless it has been disabled with SetDebugEnabled().
+        PROF_TIMER timer( "", false );
+        bool       timed = false;
+
+        auto startTimer =
+                [&]()
+                {
+                    timed = true;
+                    m_router->GetWorld()->ResetQueryCount();
+                    m_eventStats.push_back( { evt.type, 0.0, 0,
+                                              m_allocationCounter ? m_allocationCounter() : 0 } );
+                    timer.Start();
+                };
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -131,6 +152,7 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->Message( msg );
             m_reporter->Report( msg );
 
+            startTimer();
             m_router->StartRouting( evt.p, ritem, routingLayer );
             break;
         }
@@ -151,6 +173,7 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->Message( msg );
             m_reporter->Report( msg );
 
+            startTimer();
             bool rv = m_router->StartDragging( evt.p, ritem, 0 );
             break;
         }
@@ -160,8 +183,11 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->NewStage( "fix", 0, PNSLOGINFO );
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
             m_debugDecorator->Message( wxString::Format( "fix (%d, %d)", evt.p.x, evt.p.y ) );
+            startTimer();
             bool rv = m_router->FixRoute( evt.p, ritem, false, false );
-            printf( "  fix -> (%d, %d) ret %d\n", evt.p.x, evt.p.y, rv ? 1 : 0 );
+            timer.Stop();
+            m_reporter->Report( wxString::Format( "  fix -> (%d, %d) ret %d", evt.p.x, evt.p.y,
+                                                  rv ? 1 : 0 ) );
             break;
         }
 
@@ -170,7 +196,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->NewStage( "unfix", 0, PNSLOGINFO );
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
             m_debugDecorator->Message( wxString::Format( "unfix (%d, %d)", evt.p.x, evt.p.y ) );
-            printf( "  unfix\n" );
+            m_reporter->Report( wxT( "  unfix" ) );
+            startTimer();
             m_router->UndoLastSegment();
             break;
         }
@@ -185,6 +212,7 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->Message( msg );
             m_reporter->Report( msg );
 
+            startTimer();
             bool ret = m_router->Move( evt.p, ritem );
             m_debugDecorator->SetCurrentStageStatus( ret );
             break;
@@ -200,6 +228,7 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_reporter->Report( msg );
 
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
+            startTimer();
             m_router->ToggleViaPlacement();
             break;
         }
@@ -207,6 +236,19 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        timer.Stop();
+
+        if( timed )
+        {
+            EVENT_STATS& stats = m_eventStats.back();
+
+            stats.m_timeMs = timer.msecs();
+            stats.m_collisionQueries = m_router->GetWorld()->QueryCount();
+
+            if( m_allocationCounter )
+                stats.m_allocations = m_allocationCounter() - stats.m_allocations;
+        }
+
         PNS::NODE* node = nullptr;
 
 #if 0
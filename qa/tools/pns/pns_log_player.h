@@ -23,6 +23,7 @@
 #ifndef __PNS_LOG_PLAYER_H
 #define __PNS_LOG_PLAYER_H
 
+#include <functional>
 #include <map>
 #include <pcbnew/board.h>
 
@@ -93,6 +94,15 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    ///< Cost of replaying a single log event, collected for benchmarking
+    struct EVENT_STATS
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        double                  m_timeMs;           ///< time spent in the router call
+        uint64_t                m_collisionQueries; ///< NODE::QueryColliding() calls
+        uint64_t                m_allocations;      ///< heap allocations, if a counter is set
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -106,6 +116,24 @@ public:
 
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
+    /**
+     * Enable or disable the debug decorator output of the router.  Benchmarks should turn it
+     * off, as collecting the debug geometry costs more than the routing itself.
+     */
+    void SetDebugEnabled( bool aEnabled ) { m_debugEnabled = aEnabled; }
+
+    /**
+     * Set a function returning the running count of heap allocations of the process, sampled
+     * around each router call.  Without it the allocation counts are reported as 0.
+     */
+    void SetAllocationCounter( std::function<uint64_t()> aCounter )
+    {
+        m_allocationCounter = aCounter;
+    }
+
+    ///< Per-event statistics of the last ReplayLog() call
+    const std::vector<EVENT_STATS>& GetEventStats() const { return m_eventStats; }
+
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
@@ -120,6 +148,10 @@ private:
     std::unique_ptr<PNS::ROUTING_SETTINGS>      m_routingSettings;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    bool      m_debugEnabled;
+
+    std::function<uint64_t()> m_allocationCounter;
+    std::vector<EVENT_STATS>  m_eventStats;
 };
 
 #endif